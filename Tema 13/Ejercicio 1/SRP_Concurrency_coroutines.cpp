@@ -0,0 +1,167 @@
+// Variante de DataManager con corrutinas de C++20: un solo hilo atiende miles de sensores virtuales
+// Compilar: g++ -std=c++20 -O2 SRP_Concurrency_coroutines.cpp -o SRP_Concurrency_coroutines
+#include <iostream>
+#include <chrono>
+#include <string_view>
+#include <vector>
+#include <random>
+
+#include "../comun/latency_histogram.h"
+#include "coroutine_event_loop.h"
+#include "sample.h"
+
+// Simulador de la lectura de sensores: la lectura es una espera asíncrona, no bloquea el hilo
+class AsyncSensorReader {
+public:
+    AsyncSensorReader(EventLoop& loop, std::chrono::milliseconds read_time) : loop(loop), read_time(read_time) {}
+
+    // Método que simula la recogida de datos de los sensores: co_await devuelve los datos leídos
+    auto read_sensor_data() {
+        struct ReadAwaiter {
+            EventLoop& loop;
+            std::chrono::milliseconds read_time;
+
+            bool await_ready() const { return false; }
+            void await_suspend(std::coroutine_handle<> handle) {
+                loop.schedule_at(EventLoop::Clock::now() + read_time, handle);  // Simula tiempo de lectura
+            }
+            std::string_view await_resume() const { return "sensor_data"; }  // Simulación de los datos obtenidos
+        };
+        return ReadAwaiter{loop, read_time};
+    }
+
+private:
+    EventLoop& loop;
+    std::chrono::milliseconds read_time;
+};
+
+// Simulador de la comunicación LoRaWAN: el envío de la trama es una espera asíncrona
+class AsyncLoRaWANTransmitter {
+public:
+    AsyncLoRaWANTransmitter(EventLoop& loop, std::chrono::milliseconds send_time) : loop(loop), send_time(send_time) {}
+
+    // Método que simula el envío de una trama de muestras al gateway
+    auto send_frame(const std::vector<Sample>& frame) {
+        struct SendAwaiter {
+            AsyncLoRaWANTransmitter& transmitter;
+            std::size_t sample_count;
+
+            bool await_ready() const { return false; }
+            void await_suspend(std::coroutine_handle<> handle) {
+                transmitter.loop.schedule_at(EventLoop::Clock::now() + transmitter.send_time, handle);  // Simula tiempo de envío
+            }
+            void await_resume() const { transmitter.samples_sent += sample_count; }
+        };
+        return SendAwaiter{*this, frame.size()};
+    }
+
+    std::size_t sent_count() const { return samples_sent; }
+
+private:
+    EventLoop& loop;
+    std::chrono::milliseconds send_time;
+    std::size_t samples_sent = 0;
+};
+
+// Versión con corrutinas de DataManager: cada sensor y cada radio es una corrutina del mismo bucle
+class CoroutineDataManager {
+public:
+    CoroutineDataManager(EventLoop& loop, std::size_t queue_capacity, std::size_t max_samples_per_frame)
+        : loop(loop), data_queue(loop, queue_capacity), max_samples_per_frame(max_samples_per_frame) {}
+
+    // Añade un sensor virtual que se lee con su propio periodo
+    void add_sensor(AsyncSensorReader& reader, std::chrono::milliseconds period) {
+        loop.spawn(sensor_task(reader, period));
+    }
+
+    // Añade una radio que envía tramas de hasta 'max_samples_per_frame' muestras
+    void add_transmitter(AsyncLoRaWANTransmitter& transmitter) {
+        loop.spawn(transmit_task(transmitter));
+    }
+
+    std::size_t read_count() const { return samples_read; }
+
+    HistogramSnapshot total_latency() const { return latency.snapshot(); }
+
+private:
+    EventLoop& loop;
+    AsyncQueue<Sample> data_queue;
+    std::size_t max_samples_per_frame;
+    std::size_t samples_read = 0;
+    LatencyHistogram latency;
+
+    // Corrutina que lee un sensor en instantes absolutos: el periodo no deriva con el tiempo de lectura.
+    // La primera lectura se hace tras un periodo, así los sensores no arrancan todos a la vez
+    Task sensor_task(AsyncSensorReader& reader, std::chrono::milliseconds period) {
+        auto next_read = EventLoop::Clock::now() + period;
+        while (true) {
+            co_await loop.sleep_until(next_read);
+            next_read += period;
+            std::string_view data = co_await reader.read_sensor_data();
+            Sample sample;
+            sample.set_data(data);
+            sample.captured_at = EventLoop::Clock::now();
+            ++samples_read;
+            co_await data_queue.push(std::move(sample));  // Se suspende si la cola está llena
+        }
+    }
+
+    // Corrutina que espera la primera muestra y envía en la misma trama todas las que ya estén en cola
+    Task transmit_task(AsyncLoRaWANTransmitter& transmitter) {
+        std::vector<Sample> frame;
+        frame.reserve(max_samples_per_frame);
+        while (true) {
+            Sample next = co_await data_queue.pop();
+            frame.clear();
+            frame.push_back(std::move(next));
+            while (frame.size() < max_samples_per_frame && data_queue.try_pop(next)) {
+                frame.push_back(std::move(next));
+            }
+            co_await transmitter.send_frame(frame);
+            auto sent_at = EventLoop::Clock::now();
+            for (const Sample& sample : frame) {
+                latency.record(sent_at - sample.captured_at);
+            }
+        }
+    }
+};
+
+// Función principal: 10.000 sensores virtuales y 8 radios en un único hilo
+int main() {
+    const std::size_t sensor_count = 10'000;
+    const std::size_t radio_count = 8;
+
+    EventLoop loop;
+    CoroutineDataManager data_manager(loop, 4096, 64);
+
+    // Cada sensor tiene su propio periodo de lectura, entre 1 y 10 segundos
+    std::mt19937 random(42);
+    std::uniform_int_distribution<int> period_ms(1000, 10000);
+    std::vector<AsyncSensorReader> readers;
+    readers.reserve(sensor_count);
+    for (std::size_t i = 0; i < sensor_count; ++i) {
+        readers.emplace_back(loop, std::chrono::milliseconds(5));
+        data_manager.add_sensor(readers.back(), std::chrono::milliseconds(period_ms(random)));
+    }
+
+    std::vector<AsyncLoRaWANTransmitter> radios;
+    radios.reserve(radio_count);
+    for (std::size_t i = 0; i < radio_count; ++i) {
+        radios.emplace_back(loop, std::chrono::milliseconds(100));
+        data_manager.add_transmitter(radios.back());
+    }
+
+    // Simulación de ejecución por un tiempo determinado (5 segundos)
+    auto start = EventLoop::Clock::now();
+    loop.run_until(start + std::chrono::seconds(5));
+
+    std::size_t sent = 0;
+    for (const auto& radio : radios) {
+        sent += radio.sent_count();
+    }
+    std::cout << "Corrutinas activas: " << loop.task_count() << "\n";
+    std::cout << "Muestras leídas: " << data_manager.read_count() << ", enviadas: " << sent << "\n";
+    print_histogram(std::cout, "Latencia total", data_manager.total_latency());
+    std::cout << "Sistema embebido detenido." << std::endl;
+    return 0;
+}
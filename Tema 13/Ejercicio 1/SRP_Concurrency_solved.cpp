@@ -1,106 +1,45 @@
 #include <iostream>
-#include <thread>
-#include <queue>
-#include <mutex>
-#include <condition_variable>
 #include <chrono>
 
-// Simulador de la lectura de sensores
-class SensorReader {
-public:
-    // Método que simula la recogida de datos de los sensores
-    std::string read_sensor_data() {
-        std::this_thread::sleep_for(std::chrono::milliseconds(500));  // Simula tiempo de lectura
-        return "sensor_data";  // Simulación de los datos obtenidos
-    }
-};
-
-// Simulador de la comunicación LoRaWAN
-class LoRaWANTransmitter {
-public:
-    // Método que simula el envío de datos al gateway
-    void send_data(const std::string& data) {
-        std::this_thread::sleep_for(std::chrono::milliseconds(1000));  // Simula tiempo de envío
-        std::cout << "Datos enviados al gateway: " << data << std::endl;
-    }
-};
-
-// Clase que maneja la concurrencia y sincronización entre la lectura y el envío de datos
-class DataManager {
-public:
-    DataManager(SensorReader& reader, LoRaWANTransmitter& transmitter) 
-        : sensor_reader(reader), lorawan_transmitter(transmitter), stop_flag(false) {}
-
-    // Método para iniciar los hilos
-    void start() {
-        sensor_thread = std::thread(&DataManager::sensor_task, this);
-        transmit_thread = std::thread(&DataManager::transmit_task, this);
-    }
-
-    // Método para detener los hilos y limpiar los recursos
-    void stop() {
-        {
-            std::lock_guard<std::mutex> lock(mtx);
-            stop_flag = true;  // Señal para detener las tareas
-        }
-        cv.notify_all();  // Despertar el hilo de transmisión si está esperando
-        sensor_thread.join();
-        transmit_thread.join();
-    }
-
-private:
-    SensorReader& sensor_reader;
-    LoRaWANTransmitter& lorawan_transmitter;
-    std::queue<std::string> data_queue;  // Cola para almacenar los datos leídos
-    std::mutex mtx;  // Mutex para proteger la cola compartida
-    std::condition_variable cv;  // Variable de condición para sincronizar los hilos
-    std::thread sensor_thread;
-    std::thread transmit_thread;
-    bool stop_flag;
-
-    // Tarea del hilo que lee datos de los sensores
-    void sensor_task() {
-        while (!stop_flag) {
-            std::string data = sensor_reader.read_sensor_data();
-            {
-                std::lock_guard<std::mutex> lock(mtx);
-                data_queue.push(data);  // Insertar datos en la cola protegida
-                std::cout << "Datos del sensor leídos: " << data << std::endl;
-            }
-            cv.notify_one();  // Notificar al hilo de transmisión que hay datos disponibles
-        }
-    }
-
-    // Tarea del hilo que envía los datos al gateway LoRaWAN
-    void transmit_task() {
-        while (!stop_flag) {
-            std::unique_lock<std::mutex> lock(mtx);
-            cv.wait(lock, [this] { return !data_queue.empty() || stop_flag; });  // Espera hasta que haya datos o se detenga el hilo
-
-            if (!data_queue.empty()) {
-                std::string data_to_send = data_queue.front();
-                data_queue.pop();
-                lock.unlock();  // Liberar el bloqueo mientras se realiza la transmisión
-                lorawan_transmitter.send_data(data_to_send);  // Enviar los datos
-            }
-        }
-    }
-};
+#include "../comun/clock.h"
+#include "simulated_devices.h"
+#include "data_manager.h"
 
 // Función principal que ejecuta la lógica del sistema embebido
 int main() {
-    SensorReader sensor_reader;
-    LoRaWANTransmitter lorawan_transmitter;
-
-    DataManager data_manager(sensor_reader, lorawan_transmitter);
+    // Reloj de la simulación: con un SimulatedClock el mismo escenario se ejecuta en tiempo simulado
+    Clock& clock = real_time_clock();
+
+    // Dos buses de sensores y dos radios: cada radio atiende su bus y ayuda al otro si se queda sin trabajo
+    // La lectura de cada bus tarda 50 ms; el ritmo lo marca el periodo de muestreo de DataManager
+    SensorReader temperature_bus(std::chrono::milliseconds(50), true, 20.0f, clock);
+    SensorReader humidity_bus(std::chrono::milliseconds(50), true, 20.0f, clock);
+    LoRaWANTransmitter main_radio(std::chrono::milliseconds(1000), true, clock);
+    LoRaWANTransmitter backup_radio(std::chrono::milliseconds(1000), true, clock);
+
+    // Agrupa hasta 4 muestras por trama sin retener ninguna más de 1,5 segundos
+    DataManagerConfig config;
+    config.batch.max_samples = 4;
+    config.batch.max_added_latency = std::chrono::milliseconds(1500);
+    // Si la radio no da abasto, se envía siempre la lectura más reciente de cada sensor
+    config.overload_policy = OverloadPolicy::CoalesceLatest;
+    // Las lecturas por encima de 20,5 son alarmas y adelantan al resto de muestras
+    config.alarm_threshold = 20.5f;
+    config.clock = &clock;
+    // Temperatura cada 500 ms y humedad, el bus con más tráfico, cada 250 ms
+    config.sensor_sample_periods = {std::chrono::milliseconds(500), std::chrono::milliseconds(250)};
+    // Solo se envían cambios de al menos 0,3 unidades, y como mínimo una lectura cada 2 segundos
+    config.send_on_delta = {0.3f, std::chrono::seconds(2)};
+
+    DataManager data_manager({&temperature_bus, &humidity_bus}, {&main_radio, &backup_radio}, config);
     data_manager.start();
 
     // Simulación de ejecución por un tiempo determinado (5 segundos)
-    std::this_thread::sleep_for(std::chrono::seconds(5));
+    clock.sleep_for(std::chrono::seconds(5));
 
     // Detener los hilos
     data_manager.stop();
 
     std::cout << "Sistema embebido detenido." << std::endl;
     return 0;
-}
\ No newline at end of file
+}
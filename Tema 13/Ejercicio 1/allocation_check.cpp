@@ -0,0 +1,82 @@
+// Comprobación: tras el calentamiento, DataManager no reserva memoria dinámica en su camino crítico
+// Compilar: g++ -std=c++20 -O2 -pthread allocation_check.cpp -o allocation_check
+#include <iostream>
+#include <thread>
+#include <chrono>
+#include <atomic>
+#include <cstdlib>
+#include <new>
+#include <string>
+#include <filesystem>
+
+#include "simulated_devices.h"
+#include "data_manager.h"
+
+// Contador global de reservas: se sustituye el operator new de todo el programa.
+// GCC no sabe que el delete sustituido empareja con este new y avisaría de un falso positivo
+#pragma GCC diagnostic ignored "-Wmismatched-new-delete"
+static std::atomic<std::size_t> allocation_count{0};
+
+void* operator new(std::size_t size) {
+    allocation_count.fetch_add(1, std::memory_order_relaxed);
+    if (void* memory = std::malloc(size == 0 ? 1 : size)) {
+        return memory;
+    }
+    throw std::bad_alloc();
+}
+
+void operator delete(void* memory) noexcept { std::free(memory); }
+void operator delete(void* memory, std::size_t) noexcept { std::free(memory); }
+
+// Arranca DataManager, deja que se caliente y cuenta las reservas durante un intervalo de régimen permanente
+bool check_steady_state(const std::string& name, DataManagerConfig config) {
+    SensorReader fast_bus(std::chrono::milliseconds(1), false);
+    SensorReader slow_bus(std::chrono::milliseconds(3), false);
+    LoRaWANTransmitter radio(std::chrono::milliseconds(2), false);
+    config.print_stats_on_stop = false;
+
+    DataManager data_manager({&fast_bus, &slow_bus}, {&radio}, config);
+    data_manager.start();
+    std::this_thread::sleep_for(std::chrono::milliseconds(200));  // Calentamiento
+
+    std::size_t before = allocation_count.load();
+    std::size_t sent_before = radio.sent_count();
+    std::this_thread::sleep_for(std::chrono::milliseconds(500));
+    std::size_t allocations = allocation_count.load() - before;
+    std::size_t sent = radio.sent_count() - sent_before;
+
+    data_manager.stop();
+
+    bool ok = allocations == 0 && sent > 0;
+    std::cout << (ok ? "[OK]    " : "[FALLO] ") << name << ": " << sent << " muestras enviadas, "
+              << allocations << " reservas de memoria" << std::endl;
+    return ok;
+}
+
+int main() {
+    bool ok = true;
+
+    DataManagerConfig unbatched;
+    ok &= check_steady_state("Sin agrupación", unbatched);
+
+    DataManagerConfig batched;
+    batched.batch.max_samples = 8;
+    batched.batch.max_added_latency = std::chrono::milliseconds(5);
+    ok &= check_steady_state("Tramas de 8 muestras", batched);
+
+    DataManagerConfig drop_oldest;
+    drop_oldest.overload_policy = OverloadPolicy::DropOldest;
+    ok &= check_steady_state("Sobrecarga con DropOldest", drop_oldest);
+
+    DataManagerConfig coalesce_latest;
+    coalesce_latest.overload_policy = OverloadPolicy::CoalesceLatest;
+    ok &= check_steady_state("Sobrecarga con CoalesceLatest", coalesce_latest);
+
+    DataManagerConfig spill_to_disk;
+    spill_to_disk.overload_policy = OverloadPolicy::SpillToDisk;
+    spill_to_disk.spool_directory = "allocation_check_spool";
+    ok &= check_steady_state("Sobrecarga con SpillToDisk", spill_to_disk);
+    std::filesystem::remove_all(spill_to_disk.spool_directory);
+
+    return ok ? EXIT_SUCCESS : EXIT_FAILURE;
+}
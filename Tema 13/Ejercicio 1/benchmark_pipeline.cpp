@@ -0,0 +1,147 @@
+// Benchmark: filtrado, agregación, codificación y envío en el hilo de la radio frente a una cadena de etapas
+// Compilar: g++ -std=c++20 -O2 -pthread benchmark_pipeline.cpp -o benchmark_pipeline
+#include <iostream>
+#include <iomanip>
+#include <chrono>
+#include <string>
+#include <thread>
+
+#include "../comun/clock.h"
+#include "pipeline.h"
+#include "pipeline_stages.h"
+#include "simulated_devices.h"
+
+// Simula trabajo de CPU (por ejemplo, cifrado o compresión) ocupando el procesador durante 'cost'
+void burn_cpu(std::chrono::microseconds cost) {
+    auto until = std::chrono::steady_clock::now() + cost;
+    while (std::chrono::steady_clock::now() < until) {
+    }
+}
+
+// Añade a una etapa un coste de CPU fijo por elemento
+template <typename Stage>
+struct WithCpuCost {
+    Stage stage;
+    std::chrono::microseconds cost;
+
+    template <typename Item, typename Output>
+    void operator()(Item& item, Output& output) {
+        burn_cpu(cost);
+        stage(item, output);
+    }
+};
+
+// Salida que llama directamente a la siguiente función en el mismo hilo (versión sin etapas)
+template <typename Next, typename NextOutput>
+struct InlineOutput {
+    Next& next;
+    NextOutput& next_output;
+
+    template <typename T>
+    bool emit(T item) {
+        next(item, next_output);
+        return true;
+    }
+};
+
+struct InlineSink {
+    RadioSink& sink;
+
+    bool emit(EncodedFrame frame) {
+        sink(frame);
+        return true;
+    }
+};
+
+const std::chrono::microseconds filter_cost(150);   // Por muestra
+const std::chrono::microseconds encode_cost(1000);  // Por trama
+const std::chrono::milliseconds send_time(2);       // Por trama
+const std::size_t samples_per_frame = 8;
+
+// Inserta 'sample_count' muestras en 'input' y devuelve las muestras por segundo que llegan a la radio
+double feed(Pipeline& pipeline, PipelineLink<Sample>& input, std::size_t sample_count) {
+    Clock& clock = real_time_clock();
+    auto start = clock.now();
+    pipeline.start();
+    for (std::size_t i = 0; i < sample_count; ++i) {
+        Sample sample;
+        sample.set_data("sensor_data");
+        sample.captured_at = clock.now();
+        sample.sensor_id = static_cast<std::uint32_t>(i % 4);
+        sample.value = 20.0f + static_cast<float>(i % 10) / 10.0f;
+        input.push_wait(sample);
+    }
+    pipeline.stop();  // Espera a que todo se haya enviado
+    std::chrono::duration<double> elapsed = clock.now() - start;
+    return sample_count / elapsed.count();
+}
+
+// Todo el trabajo en el hilo de la radio: el coste de CPU se suma al tiempo de envío
+double run_serial(std::size_t sample_count) {
+    Clock& clock = real_time_clock();
+    LoRaWANTransmitter radio(send_time, false);
+    Pipeline pipeline(clock);
+    auto& input = pipeline.make_input<Sample>();
+
+    struct SerialWork {
+        WithCpuCost<RangeFilter> filter;
+        FrameAggregator aggregator;
+        WithCpuCost<FrameEncoder> encoder;
+        RadioSink sink;
+
+        void operator()(Sample& sample) {
+            InlineSink radio_output{sink};
+            InlineOutput<WithCpuCost<FrameEncoder>, InlineSink> encoder_output{encoder, radio_output};
+            InlineOutput<FrameAggregator, decltype(encoder_output)> aggregator_output{aggregator, encoder_output};
+            filter(sample, aggregator_output);
+        }
+    };
+    pipeline.add_sink("todo en la radio", input,
+                      SerialWork{{RangeFilter(-40.0f, 85.0f), filter_cost},
+                                 FrameAggregator(clock, samples_per_frame, std::chrono::seconds(1)),
+                                 {FrameEncoder(), encode_cost},
+                                 RadioSink(radio, clock)});
+    double throughput = feed(pipeline, input, sample_count);
+    pipeline.print_stage_stats(std::cout);
+    return throughput;
+}
+
+// Una etapa por hilo: mientras la radio envía una trama, las etapas anteriores preparan las siguientes
+double run_pipelined(std::size_t sample_count) {
+    Clock& clock = real_time_clock();
+    LoRaWANTransmitter radio(send_time, false);
+    Pipeline pipeline(clock);
+
+    // Con núcleos de sobra, cada etapa va a su propio núcleo
+    unsigned cores = std::thread::hardware_concurrency();
+    auto core = [cores](int index) { return StageOptions{cores >= 4 ? index : -1}; };
+
+    auto& input = pipeline.make_input<Sample>();
+    auto& filtered = pipeline.add_stage<Sample>("filtrado", input,
+                                                WithCpuCost<RangeFilter>{RangeFilter(-40.0f, 85.0f), filter_cost}, core(0));
+    auto& frames = pipeline.add_stage<SampleFrame>("agregación", filtered,
+                                                   FrameAggregator(clock, samples_per_frame, std::chrono::seconds(1)), core(1));
+    auto& encoded = pipeline.add_stage<EncodedFrame>("codificación", frames,
+                                                     WithCpuCost<FrameEncoder>{FrameEncoder(), encode_cost}, core(2));
+    pipeline.add_sink("transmisión", encoded, RadioSink(radio, clock), core(3));
+
+    double throughput = feed(pipeline, input, sample_count);
+    pipeline.print_stage_stats(std::cout);
+    return throughput;
+}
+
+int main() {
+    const std::size_t sample_count = 4000;
+
+    std::cout << "Filtrado " << filter_cost.count() << " us/muestra, codificación " << encode_cost.count()
+              << " us/trama, envío " << send_time.count() << " ms/trama de " << samples_per_frame << " muestras\n\n";
+    double serial = run_serial(sample_count);
+    std::cout << "\n";
+    double pipelined = run_pipelined(sample_count);
+
+    std::cout << "\n" << std::left << std::setw(28) << "Organización" << std::right << std::setw(14) << "muestras/s" << "\n";
+    std::cout << std::left << std::setw(28) << "Todo en el hilo de la radio" << std::right << std::setw(14)
+              << std::fixed << std::setprecision(0) << serial << "\n";
+    std::cout << std::left << std::setw(28) << "Cadena de etapas" << std::right << std::setw(14) << pipelined << "\n";
+    return 0;
+}
@@ -0,0 +1,31 @@
+// Benchmark: latencia de las alarmas frente al tráfico ordinario con la radio saturada
+// Compilar: g++ -std=c++20 -O2 -pthread benchmark_priority.cpp -o benchmark_priority
+#include <iostream>
+#include <thread>
+#include <chrono>
+
+#include "simulated_devices.h"
+#include "data_manager.h"
+
+int main() {
+    // El bus de telemetría produce mucho más de lo que puede enviar la radio, así que su cola siempre está llena.
+    // El sensor de alarmas lee cada 100 ms valores que siempre superan el umbral
+    SensorReader telemetry_bus(std::chrono::milliseconds(1), false, 20.0f);
+    SensorReader alarm_sensor(std::chrono::milliseconds(100), false, 100.0f);
+    LoRaWANTransmitter radio(std::chrono::milliseconds(20), false);
+
+    DataManagerConfig config;
+    config.print_stats_on_stop = false;
+    config.alarm_threshold = 50.0f;
+
+    DataManager data_manager({&telemetry_bus, &alarm_sensor}, {&radio}, config);
+    data_manager.start();
+    std::this_thread::sleep_for(std::chrono::seconds(3));
+    data_manager.stop();
+
+    LatencyStats stats = data_manager.latency_stats();
+    std::cout << "Cola ordinaria saturada, envío de 20 ms por muestra\n";
+    print_histogram(std::cout, "Todas las muestras", stats.total);
+    print_histogram(std::cout, "Alarmas", stats.alarm_total);
+    return 0;
+}
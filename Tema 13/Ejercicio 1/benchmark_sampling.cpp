@@ -0,0 +1,71 @@
+// Benchmark: bucle con sleep_for seguido de la lectura frente a PeriodicSampler con plazos absolutos
+// Compilar: g++ -std=c++20 -O2 -pthread benchmark_sampling.cpp -o benchmark_sampling
+#include <iostream>
+#include <iomanip>
+#include <chrono>
+#include <vector>
+#include <string>
+#include <functional>
+
+#include "../comun/clock.h"
+#include "periodic_sampler.h"
+
+struct SamplingResult {
+    double mean_period_ms;  // Periodo real medio
+    double drift_ms;        // Desfase del último muestreo respecto a inicio + n * periodo
+    double p99_error_ms;    // Percentil 99 del desfase de cada muestreo respecto a su instante ideal
+};
+
+// Ejecuta 'tick_count' muestreos: 'wait' espera al siguiente y después se simula una lectura de 'read_time'
+SamplingResult run_benchmark(std::size_t tick_count, Clock::duration period, Clock::duration read_time,
+                             const std::function<void()>& wait) {
+    Clock& clock = real_time_clock();
+    LatencyHistogram error;
+    auto start = clock.now();
+    Clock::time_point last;
+    for (std::size_t i = 0; i < tick_count; ++i) {
+        wait();
+        last = clock.now();
+        error.record(last - (start + static_cast<Clock::duration::rep>(i) * period));
+        clock.sleep_for(read_time);  // Lectura del sensor
+    }
+    auto ms = [](Clock::duration value) { return std::chrono::duration<double, std::milli>(value).count(); };
+    HistogramSnapshot snapshot = error.snapshot();
+    return {ms(last - start) / static_cast<double>(tick_count - 1),
+            ms(last - (start + static_cast<Clock::duration::rep>(tick_count - 1) * period)),
+            ms(snapshot.percentile(0.99))};
+}
+
+void print_result(const std::string& name, const SamplingResult& result) {
+    std::cout << std::left << std::setw(28) << name << std::right << std::fixed << std::setprecision(3)
+              << std::setw(14) << result.mean_period_ms
+              << std::setw(14) << result.drift_ms
+              << std::setw(18) << result.p99_error_ms << "\n";
+}
+
+int main() {
+    const std::size_t tick_count = 200;
+    const Clock::duration period = std::chrono::milliseconds(10);
+    const Clock::duration read_time = std::chrono::milliseconds(2);
+    Clock& clock = real_time_clock();
+
+    std::cout << "Periodo nominal 10 ms, lectura de 2 ms, " << tick_count << " muestreos\n";
+    std::cout << std::left << std::setw(28) << "Muestreo"
+              << std::right << std::setw(14) << "periodo (ms)"
+              << std::setw(14) << "deriva (ms)" << std::setw(18) << "p99 desfase (ms)" << "\n";
+
+    // Como hacía sensor_task: una espera relativa y después la lectura. El periodo real es espera + lectura
+    bool first = true;
+    print_result("sleep_for + lectura", run_benchmark(tick_count, period, read_time, [&] {
+        if (!first) {
+            clock.sleep_for(period);
+        }
+        first = false;
+    }));
+
+    PeriodicSampler sampler(clock, period);
+    sampler.start();
+    print_result("PeriodicSampler", run_benchmark(tick_count, period, read_time, [&] { sampler.wait_next(); }));
+    print_sampling_stats(std::cout, "PeriodicSampler", sampler.stats());
+    return 0;
+}
@@ -0,0 +1,64 @@
+// Benchmark: una hora de una señal lenta en tiempo simulado, enviando cada lectura o solo los cambios
+// Compilar: g++ -std=c++20 -O2 -pthread benchmark_send_on_delta.cpp -o benchmark_send_on_delta
+#include <iostream>
+#include <iomanip>
+#include <chrono>
+#include <string>
+
+#include "../comun/clock.h"
+#include "simulated_devices.h"
+#include "data_manager.h"
+
+struct ScenarioResult {
+    std::size_t sent;          // Muestras que llegaron al gateway
+    Clock::duration airtime;   // Tiempo total de radio ocupado
+    double suppression_ratio;  // Fracción de lecturas suprimidas
+};
+
+ScenarioResult run_scenario(DeltaConfig delta) {
+    const auto scenario_length = std::chrono::hours(1);
+    SimulatedClock clock;
+
+    // Cuatro sensores leídos cada segundo; su valor cambia poco de una lectura a otra
+    SensorReader bus_a(std::chrono::milliseconds(20), false, 20.0f, clock);
+    SensorReader bus_b(std::chrono::milliseconds(20), false, 20.0f, clock);
+    SensorReader bus_c(std::chrono::milliseconds(20), false, 20.0f, clock);
+    SensorReader bus_d(std::chrono::milliseconds(20), false, 20.0f, clock);
+    LoRaWANTransmitter radio(std::chrono::milliseconds(400), false, clock);
+
+    DataManagerConfig config;
+    config.sample_period = std::chrono::seconds(1);
+    config.send_on_delta = delta;
+    config.print_stats_on_stop = false;
+    config.clock = &clock;
+
+    DataManager data_manager({&bus_a, &bus_b, &bus_c, &bus_d}, {&radio}, config);
+    data_manager.start();
+    clock.sleep_for(scenario_length);
+    data_manager.stop();
+
+    SuppressionStats total;
+    for (const SuppressionStats& stats : data_manager.suppression_stats()) {
+        total.forwarded += stats.forwarded;
+        total.suppressed += stats.suppressed;
+    }
+    return {radio.sent_count(), data_manager.latency_stats().send.count * std::chrono::milliseconds(400),
+            total.ratio()};
+}
+
+void print_result(const std::string& name, const ScenarioResult& result) {
+    std::cout << std::left << std::setw(32) << name << std::right << std::fixed << std::setprecision(1)
+              << std::setw(10) << result.sent
+              << std::setw(16) << std::chrono::duration<double>(result.airtime).count()
+              << std::setw(14) << result.suppression_ratio * 100.0 << "\n";
+}
+
+int main() {
+    std::cout << std::left << std::setw(32) << "Envío" << std::right << std::setw(10) << "muestras"
+              << std::setw(16) << "radio (s)" << std::setw(14) << "suprimidas %" << "\n";
+    print_result("Todas las lecturas", run_scenario({}));
+    print_result("Banda muerta 1.0", run_scenario({1.0f, Clock::duration::zero()}));
+    print_result("Banda muerta 1.0, latido 60 s", run_scenario({1.0f, std::chrono::seconds(60)}));
+    print_result("Banda muerta 2.0, latido 60 s", run_scenario({2.0f, std::chrono::seconds(60)}));
+    return 0;
+}
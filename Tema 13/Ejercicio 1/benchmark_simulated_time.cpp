@@ -0,0 +1,46 @@
+// Benchmark: una hora de tráfico de DataManager reproducida en tiempo simulado
+// Compilar: g++ -std=c++20 -O2 -pthread benchmark_simulated_time.cpp -o benchmark_simulated_time
+#include <iostream>
+#include <iomanip>
+#include <chrono>
+
+#include "../comun/clock.h"
+#include "simulated_devices.h"
+#include "data_manager.h"
+
+int main() {
+    const auto scenario_length = std::chrono::hours(1);
+
+    // El hilo principal ya participa en el reloj al crearlo
+    SimulatedClock clock;
+
+    // Cuatro buses de sensores y dos radios con los mismos tiempos que el ejemplo principal
+    SensorReader bus_a(std::chrono::milliseconds(500), false, 20.0f, clock);
+    SensorReader bus_b(std::chrono::milliseconds(500), false, 20.0f, clock);
+    SensorReader bus_c(std::chrono::milliseconds(250), false, 20.0f, clock);
+    SensorReader bus_d(std::chrono::milliseconds(1000), false, 20.0f, clock);
+    LoRaWANTransmitter radio_a(std::chrono::milliseconds(1000), false, clock);
+    LoRaWANTransmitter radio_b(std::chrono::milliseconds(1000), false, clock);
+
+    DataManagerConfig config;
+    config.batch.max_samples = 8;
+    config.batch.max_added_latency = std::chrono::milliseconds(2000);
+    config.print_stats_on_stop = false;
+    config.clock = &clock;
+
+    auto wall_start = std::chrono::steady_clock::now();
+    DataManager data_manager({&bus_a, &bus_b, &bus_c, &bus_d}, {&radio_a, &radio_b}, config);
+    data_manager.start();
+    clock.sleep_for(scenario_length);
+    data_manager.stop();
+    std::chrono::duration<double> wall_time = std::chrono::steady_clock::now() - wall_start;
+
+    std::chrono::duration<double> simulated_time = scenario_length;
+    std::size_t sent = radio_a.sent_count() + radio_b.sent_count();
+    std::cout << std::fixed << std::setprecision(2)
+              << "Tiempo simulado: " << simulated_time.count() << " s, tiempo real: " << wall_time.count() << " s ("
+              << simulated_time.count() / wall_time.count() << "x)\n"
+              << "Muestras enviadas: " << sent << " (" << sent / simulated_time.count() << " muestras/s simuladas)\n";
+    data_manager.print_latency_stats(std::cout);
+    return 0;
+}
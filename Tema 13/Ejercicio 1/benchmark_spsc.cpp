@@ -0,0 +1,176 @@
+// Benchmark: cola con mutex + condition_variable frente a la cola circular SPSC sin mutex
+// Compilar: g++ -std=c++20 -O2 -pthread benchmark_spsc.cpp -o benchmark_spsc
+#include <iostream>
+#include <iomanip>
+#include <thread>
+#include <queue>
+#include <mutex>
+#include <condition_variable>
+#include <chrono>
+#include <vector>
+#include <string>
+#include <algorithm>
+#include <atomic>
+#include <cstdint>
+#include <cstdlib>
+
+#include "spsc_ring_buffer.h"
+
+using BenchmarkClock = std::chrono::steady_clock;
+
+// Muestra que viaja del hilo del sensor al hilo de transmisión
+struct TimedSample {
+    std::int64_t captured_ns = 0;  // Instante en el que el productor la insertó
+    std::string data;
+};
+
+std::int64_t now_ns() {
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(BenchmarkClock::now().time_since_epoch()).count();
+}
+
+// Cola equivalente a la que usaba DataManager antes de la cola circular
+class MutexQueue {
+public:
+    void push(TimedSample sample) {
+        {
+            std::lock_guard<std::mutex> lock(mtx);
+            samples.push(std::move(sample));
+        }
+        cv.notify_one();
+    }
+
+    void pop(TimedSample& sample) {
+        std::unique_lock<std::mutex> lock(mtx);
+        cv.wait(lock, [this] { return !samples.empty(); });
+        sample = std::move(samples.front());
+        samples.pop();
+    }
+
+private:
+    std::queue<TimedSample> samples;
+    std::mutex mtx;
+    std::condition_variable cv;
+};
+
+// Adaptador para usar la cola circular con la misma interfaz que MutexQueue
+class RingQueue {
+public:
+    void push(TimedSample sample) { ring.push_wait(std::move(sample)); }
+    void pop(TimedSample& sample) { ring.pop_wait(sample); }
+
+private:
+    SpscRingBuffer<TimedSample, 1024> ring;
+};
+
+struct BenchmarkResult {
+    double samples_per_second;
+    double p50_latency_us;
+    double p99_latency_us;
+};
+
+// Un productor inserta 'sample_count' muestras y un consumidor mide cuánto tarda cada una en llegarle
+template <typename Queue>
+BenchmarkResult run_benchmark(std::size_t sample_count) {
+    Queue queue;
+    std::vector<std::int64_t> latencies_ns(sample_count);
+
+    auto start = BenchmarkClock::now();
+    std::thread consumer([&] {
+        TimedSample sample;
+        for (std::size_t i = 0; i < sample_count; ++i) {
+            queue.pop(sample);
+            latencies_ns[i] = now_ns() - sample.captured_ns;
+        }
+    });
+    std::thread producer([&] {
+        for (std::size_t i = 0; i < sample_count; ++i) {
+            queue.push(TimedSample{now_ns(), "sensor_data"});
+        }
+    });
+    producer.join();
+    consumer.join();
+    std::chrono::duration<double> elapsed = BenchmarkClock::now() - start;
+
+    std::sort(latencies_ns.begin(), latencies_ns.end());
+    auto percentile_us = [&](double p) {
+        return latencies_ns[static_cast<std::size_t>(p * (sample_count - 1))] / 1000.0;
+    };
+    return {sample_count / elapsed.count(), percentile_us(0.50), percentile_us(0.99)};
+}
+
+// Comprobación de cierre: el productor inserta y cierra justo después; el consumidor, bloqueado en pop_wait,
+// tiene que recibir todos los elementos aunque vea la cola cerrada antes de ver el último
+bool drains_on_close(int rounds) {
+    for (int round = 0; round < rounds; ++round) {
+        SpscRingBuffer<int, 4> ring;
+        int received = 0;
+        std::thread consumer([&] {
+            int value = 0;
+            while (ring.pop_wait(value)) {
+                ++received;
+            }
+        });
+        ring.push_wait(1);
+        ring.push_wait(2);
+        ring.close();
+        consumer.join();
+        if (received != 2) {
+            std::cout << "Ronda " << round << ": se recibieron " << received << " de 2 elementos\n";
+            return false;
+        }
+    }
+    return true;
+}
+
+// Un tercer hilo consulta size() mientras productor y consumidor trabajan: nunca debe pasar de la capacidad
+// (con la cola leída antes que la cabeza, la resta podía dar la vuelta y devolver casi SIZE_MAX)
+bool size_stays_in_range(int items) {
+    SpscRingBuffer<int, 64> ring;
+    std::atomic<bool> done{false};
+    std::size_t largest = 0;
+    std::thread observer([&] {
+        while (!done.load(std::memory_order_relaxed)) {
+            largest = std::max(largest, ring.size());
+        }
+    });
+    std::thread consumer([&] {
+        int value = 0;
+        while (ring.pop_wait(value)) {
+        }
+    });
+    for (int i = 0; i < items; ++i) {
+        ring.push_wait(i);
+    }
+    ring.close();
+    consumer.join();
+    done = true;
+    observer.join();
+    if (largest > ring.capacity()) {
+        std::cout << "size() devolvió " << largest << " con capacidad " << ring.capacity() << "\n";
+        return false;
+    }
+    return true;
+}
+
+void print_result(const std::string& name, const BenchmarkResult& result) {
+    std::cout << std::left << std::setw(28) << name
+              << std::right << std::setw(14) << std::fixed << std::setprecision(0) << result.samples_per_second
+              << std::setw(12) << std::setprecision(2) << result.p50_latency_us
+              << std::setw(12) << result.p99_latency_us << "\n";
+}
+
+int main() {
+    const std::size_t sample_count = 1'000'000;
+
+    std::cout << std::left << std::setw(28) << "Cola"
+              << std::right << std::setw(14) << "muestras/s"
+              << std::setw(12) << "p50 (us)" << std::setw(12) << "p99 (us)" << "\n";
+    print_result("std::queue + mutex + cv", run_benchmark<MutexQueue>(sample_count));
+    print_result("SpscRingBuffer", run_benchmark<RingQueue>(sample_count));
+
+    bool drained = drains_on_close(10'000);
+    std::cout << "Cierre con elementos pendientes: " << (drained ? "OK" : "FALLO") << "\n";
+    bool size_ok = size_stays_in_range(2'000'000);
+    std::cout << "size() consultado desde otro hilo: " << (size_ok ? "OK" : "FALLO") << "\n";
+    return drained && size_ok ? EXIT_SUCCESS : EXIT_FAILURE;
+}
@@ -0,0 +1,100 @@
+// Benchmark: jitter del muestreo de DataManager con carga de fondo, según la colocación y planificación de sus hilos
+// Compilar: g++ -std=c++20 -O2 -pthread benchmark_thread_config.cpp -o benchmark_thread_config
+// SCHED_FIFO y mlockall requieren privilegios (root o CAP_SYS_NICE / CAP_IPC_LOCK)
+#include <iostream>
+#include <iomanip>
+#include <atomic>
+#include <chrono>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "simulated_devices.h"
+#include "data_manager.h"
+#include "thread_config.h"
+
+// Hilos que ocupan la CPU sin descanso, como lo haría otra aplicación del mismo equipo
+class BackgroundLoad {
+public:
+    BackgroundLoad(unsigned thread_count, const ThreadConfig& placement) {
+        for (unsigned i = 0; i < thread_count; ++i) {
+            threads.emplace_back([this] {
+                volatile std::uint64_t work = 0;
+                while (!stop_flag.load(std::memory_order_relaxed)) {
+                    work = work + 1;
+                }
+            });
+            apply_thread_config(threads.back(), placement);
+        }
+    }
+
+    ~BackgroundLoad() {
+        stop_flag = true;
+        for (auto& thread : threads) {
+            thread.join();
+        }
+    }
+
+private:
+    std::atomic<bool> stop_flag{false};
+    std::vector<std::thread> threads;
+};
+
+// Dos sensores leídos cada 2 ms durante 'length' mientras la carga ocupa todos los núcleos
+void run_scenario(const std::string& name, const ThreadConfig& data_manager_threads, const ThreadConfig& load_placement,
+                  bool lock_memory, std::chrono::seconds length) {
+    unsigned cores = std::max(1u, std::thread::hardware_concurrency());
+    BackgroundLoad load(cores * 2, load_placement);
+
+    SensorReader bus_a(std::chrono::milliseconds(0), false);
+    SensorReader bus_b(std::chrono::milliseconds(0), false);
+    LoRaWANTransmitter radio(std::chrono::milliseconds(0), false);
+
+    DataManagerConfig config;
+    config.sample_period = std::chrono::milliseconds(2);
+    config.overload_policy = OverloadPolicy::DropOldest;
+    config.print_stats_on_stop = false;
+    config.sensor_threads = data_manager_threads;
+    config.transmit_threads = data_manager_threads;
+    config.lock_memory = lock_memory;
+
+    DataManager data_manager({&bus_a, &bus_b}, {&radio}, config);
+    data_manager.start();
+    std::this_thread::sleep_for(length);
+    data_manager.stop();
+
+    auto ms = [](std::chrono::nanoseconds value) { return value.count() / 1e6; };
+    for (const SamplingStats& stats : data_manager.sampling_stats()) {
+        std::cout << std::left << std::setw(36) << name << std::right << std::fixed << std::setprecision(3)
+                  << std::setw(10) << ms(stats.jitter.percentile(0.50))
+                  << std::setw(10) << ms(stats.jitter.percentile(0.99))
+                  << std::setw(10) << ms(std::chrono::nanoseconds(stats.jitter.max_ns))
+                  << std::setw(10) << stats.missed_deadlines << "\n";
+    }
+}
+
+int main() {
+    const auto length = std::chrono::seconds(3);
+    unsigned cores = std::max(1u, std::thread::hardware_concurrency());
+    int isolated_core = static_cast<int>(cores) - 1;
+
+    // Núcleo "aislado": el último queda para DataManager y la carga se reparte en los demás.
+    // Con un solo núcleo no hay dónde aislarlo y la carga lo comparte
+    ThreadConfig on_isolated_core;
+    on_isolated_core.cpus = {isolated_core};
+    ThreadConfig load_elsewhere;
+    for (int cpu = 0; cpu < isolated_core; ++cpu) {
+        load_elsewhere.cpus.push_back(cpu);
+    }
+    ThreadConfig realtime = on_isolated_core;
+    realtime.policy = SchedulingPolicy::Fifo;
+    realtime.priority = 80;
+
+    std::cout << "Periodo 2 ms, " << cores << " núcleo(s), carga de fondo en " << cores * 2 << " hilos\n";
+    std::cout << std::left << std::setw(36) << "Hilos de DataManager" << std::right << std::setw(10) << "p50 (ms)"
+              << std::setw(10) << "p99 (ms)" << std::setw(10) << "max (ms)" << std::setw(10) << "perdidos" << "\n";
+    run_scenario("SCHED_OTHER, sin afinidad", {}, {}, false, length);
+    run_scenario("SCHED_OTHER, núcleo aislado", on_isolated_core, load_elsewhere, false, length);
+    run_scenario("SCHED_FIFO 80, núcleo aislado, mlock", realtime, load_elsewhere, true, length);
+    return 0;
+}
@@ -0,0 +1,71 @@
+// Benchmark: rendimiento de DataManager según el número de transmisores
+// Compilar: g++ -std=c++20 -O2 -pthread benchmark_worker_pool.cpp -o benchmark_worker_pool
+#include <iostream>
+#include <iomanip>
+#include <thread>
+#include <chrono>
+#include <memory>
+#include <vector>
+
+#include "simulated_devices.h"
+#include "data_manager.h"
+
+struct PoolResult {
+    double samples_per_second;
+    std::size_t stolen;
+};
+
+// Los lectores producen más rápido de lo que puede enviar un solo transmisor;
+// el primer bus es el doble de rápido que el resto para forzar el robo de trabajo
+PoolResult run_benchmark(std::size_t reader_count, std::size_t transmitter_count, std::chrono::milliseconds duration) {
+    std::vector<std::unique_ptr<SensorReader>> readers;
+    std::vector<std::unique_ptr<LoRaWANTransmitter>> transmitters;
+    std::vector<SensorReader*> reader_ptrs;
+    std::vector<LoRaWANTransmitter*> transmitter_ptrs;
+
+    for (std::size_t i = 0; i < reader_count; ++i) {
+        auto read_time = std::chrono::milliseconds(i == 0 ? 1 : 2);
+        readers.push_back(std::make_unique<SensorReader>(read_time, false));
+        reader_ptrs.push_back(readers.back().get());
+    }
+    for (std::size_t i = 0; i < transmitter_count; ++i) {
+        transmitters.push_back(std::make_unique<LoRaWANTransmitter>(std::chrono::milliseconds(10), false));
+        transmitter_ptrs.push_back(transmitters.back().get());
+    }
+
+    DataManagerConfig config;
+    config.print_stats_on_stop = false;
+    DataManager data_manager(reader_ptrs, transmitter_ptrs, config);
+    data_manager.start();
+    std::this_thread::sleep_for(duration);
+    data_manager.stop();
+
+    std::size_t sent = 0;
+    for (const auto& transmitter : transmitters) {
+        sent += transmitter->sent_count();
+    }
+    std::chrono::duration<double> seconds = duration;
+    return {sent / seconds.count(), data_manager.stolen_count()};
+}
+
+int main() {
+    const std::size_t reader_count = 8;
+    const auto duration = std::chrono::seconds(2);
+
+    std::cout << "Lectores: " << reader_count << ", envío simulado de 10 ms por muestra\n";
+    std::cout << std::setw(14) << "transmisores" << std::setw(14) << "muestras/s"
+              << std::setw(12) << "escalado" << std::setw(12) << "robadas" << "\n";
+
+    double baseline = 0.0;
+    for (std::size_t transmitters : {1, 2, 4, 8}) {
+        PoolResult result = run_benchmark(reader_count, transmitters, duration);
+        if (baseline == 0.0) {
+            baseline = result.samples_per_second;
+        }
+        std::cout << std::setw(14) << transmitters
+                  << std::setw(14) << std::fixed << std::setprecision(0) << result.samples_per_second
+                  << std::setw(11) << std::setprecision(2) << result.samples_per_second / baseline << "x"
+                  << std::setw(12) << result.stolen << "\n";
+    }
+    return 0;
+}
@@ -0,0 +1,28 @@
+#ifndef CLOCK_WAIT_H
+#define CLOCK_WAIT_H
+
+#include <functional>
+
+#include "../comun/clock.h"
+#include "spsc_ring_buffer.h"
+
+// Adaptador para que las esperas de las colas pasen por un reloj inyectado. Solo hace falta con un reloj
+// simulado: en tiempo real las colas se quedan con su propia espera, que no toma ningún mutex si nadie espera
+class ClockWait : public ExternalWait {
+public:
+    explicit ClockWait(Clock& clock) : clock(clock) {}
+
+    // Espera que hay que dar a las colas: este adaptador si el reloj es simulado, nullptr si no
+    ExternalWait* for_queues() { return clock.is_simulated() ? this : nullptr; }
+
+    bool wait_until(time_point deadline, const std::function<bool()>& ready) override {
+        return clock.wait_until(deadline, ready);
+    }
+
+    void notify_waiters() override { clock.notify_waiters(); }
+
+private:
+    Clock& clock;
+};
+
+#endif  // CLOCK_WAIT_H
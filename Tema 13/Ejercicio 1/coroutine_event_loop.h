@@ -0,0 +1,243 @@
+#ifndef COROUTINE_EVENT_LOOP_H
+#define COROUTINE_EVENT_LOOP_H
+
+#include <chrono>
+#include <coroutine>
+#include <cstddef>
+#include <deque>
+#include <functional>
+#include <optional>
+#include <queue>
+#include <thread>
+#include <unordered_set>
+#include <utility>
+#include <vector>
+
+class EventLoop;
+
+// Corrutina lanzada en el bucle de eventos. No devuelve nada: se destruye sola al terminar
+// o la destruye el bucle si sigue suspendida cuando este se destruye
+class Task {
+public:
+    struct promise_type {
+        EventLoop* loop = nullptr;
+
+        Task get_return_object() { return Task(std::coroutine_handle<promise_type>::from_promise(*this)); }
+        std::suspend_always initial_suspend() noexcept { return {}; }  // Arranca cuando la lance el bucle
+
+        struct FinalAwaiter {
+            bool await_ready() noexcept { return false; }
+            void await_suspend(std::coroutine_handle<promise_type> handle) noexcept;
+            void await_resume() noexcept {}
+        };
+        FinalAwaiter final_suspend() noexcept { return {}; }
+
+        void return_void() {}
+        void unhandled_exception() { std::terminate(); }
+    };
+
+    explicit Task(std::coroutine_handle<promise_type> handle) : handle(handle) {}
+    Task(Task&& other) noexcept : handle(std::exchange(other.handle, nullptr)) {}
+    Task(const Task&) = delete;
+    Task& operator=(const Task&) = delete;
+    ~Task() {
+        if (handle) {
+            handle.destroy();  // Nunca se llegó a lanzar
+        }
+    }
+
+private:
+    friend class EventLoop;
+    std::coroutine_handle<promise_type> handle;
+};
+
+// Bucle de eventos de un solo hilo con cola de temporizadores.
+// Miles de corrutinas suspendidas solo ocupan su marco en memoria: ningún hilo queda bloqueado por ellas
+class EventLoop {
+public:
+    using Clock = std::chrono::steady_clock;
+
+    EventLoop() = default;
+    EventLoop(const EventLoop&) = delete;
+    EventLoop& operator=(const EventLoop&) = delete;
+
+    ~EventLoop() {
+        for (void* address : live_tasks) {
+            std::coroutine_handle<>::from_address(address).destroy();
+        }
+    }
+
+    // Lanza una corrutina: empezará a ejecutarse en la siguiente vuelta del bucle
+    void spawn(Task task) {
+        auto handle = std::exchange(task.handle, nullptr);
+        handle.promise().loop = this;
+        live_tasks.insert(handle.address());
+        schedule(handle);
+    }
+
+    // Reanuda 'handle' en la siguiente vuelta del bucle
+    void schedule(std::coroutine_handle<> handle) { ready.push_back(handle); }
+
+    // Reanuda 'handle' cuando se alcance 'when'
+    void schedule_at(Clock::time_point when, std::coroutine_handle<> handle) {
+        timers.push(Timer{when, next_timer_id++, handle});
+    }
+
+    // Espera asíncrona: suspende la corrutina sin bloquear el hilo
+    auto sleep_until(Clock::time_point when) {
+        struct SleepAwaiter {
+            EventLoop& loop;
+            Clock::time_point when;
+
+            bool await_ready() const { return when <= Clock::now(); }
+            void await_suspend(std::coroutine_handle<> handle) { loop.schedule_at(when, handle); }
+            void await_resume() const {}
+        };
+        return SleepAwaiter{*this, when};
+    }
+
+    auto sleep_for(Clock::duration duration) { return sleep_until(Clock::now() + duration); }
+
+    // Ejecuta corrutinas y temporizadores hasta 'deadline'. El hilo solo duerme cuando no hay nada listo
+    void run_until(Clock::time_point deadline) {
+        while (true) {
+            while (!ready.empty()) {
+                auto handle = ready.front();
+                ready.pop_front();
+                handle.resume();
+            }
+
+            Clock::time_point now = Clock::now();
+            if (now >= deadline) {
+                return;
+            }
+            if (timers.empty() || timers.top().when > now) {
+                Clock::time_point wake = timers.empty() ? deadline : std::min(timers.top().when, deadline);
+                std::this_thread::sleep_until(wake);
+                now = Clock::now();
+            }
+            while (!timers.empty() && timers.top().when <= now) {
+                ready.push_back(timers.top().handle);
+                timers.pop();
+            }
+        }
+    }
+
+    std::size_t task_count() const { return live_tasks.size(); }
+
+private:
+    friend struct Task::promise_type::FinalAwaiter;
+
+    struct Timer {
+        Clock::time_point when;
+        std::size_t id;  // Desempate: a igual instante, orden de llegada
+        std::coroutine_handle<> handle;
+
+        bool operator>(const Timer& other) const {
+            return when != other.when ? when > other.when : id > other.id;
+        }
+    };
+
+    std::priority_queue<Timer, std::vector<Timer>, std::greater<>> timers;
+    std::deque<std::coroutine_handle<>> ready;
+    std::unordered_set<void*> live_tasks;
+    std::size_t next_timer_id = 0;
+};
+
+inline void Task::promise_type::FinalAwaiter::await_suspend(std::coroutine_handle<promise_type> handle) noexcept {
+    handle.promise().loop->live_tasks.erase(handle.address());
+    handle.destroy();
+}
+
+// Cola acotada entre corrutinas del mismo bucle. Si no hay datos, quien extrae se suspende;
+// si está llena, quien inserta se suspende. Los elementos se entregan directamente al que espera
+template <typename T>
+class AsyncQueue {
+public:
+    AsyncQueue(EventLoop& loop, std::size_t capacity) : loop(loop), capacity(capacity) {}
+
+    // Inserta sin suspender. Devuelve false si la cola está llena
+    bool try_push(T& item) {
+        if (!pop_waiters.empty()) {
+            PopAwaiter* waiter = pop_waiters.front();
+            pop_waiters.pop_front();
+            waiter->value = std::move(item);
+            loop.schedule(waiter->handle);
+            return true;
+        }
+        if (items.size() >= capacity) {
+            return false;
+        }
+        items.push_back(std::move(item));
+        return true;
+    }
+
+    // Extrae sin suspender. Devuelve false si la cola está vacía
+    bool try_pop(T& item) {
+        if (items.empty()) {
+            return false;
+        }
+        item = std::move(items.front());
+        items.pop_front();
+        admit_waiting_producer();
+        return true;
+    }
+
+    struct PushAwaiter {
+        AsyncQueue& queue;
+        T item;
+        std::coroutine_handle<> handle;
+
+        bool await_ready() { return queue.try_push(item); }
+        void await_suspend(std::coroutine_handle<> h) {
+            handle = h;
+            queue.push_waiters.push_back(this);
+        }
+        void await_resume() const {}
+    };
+
+    struct PopAwaiter {
+        AsyncQueue& queue;
+        std::optional<T> value;
+        std::coroutine_handle<> handle;
+
+        bool await_ready() {
+            T item;
+            if (!queue.try_pop(item)) {
+                return false;
+            }
+            value = std::move(item);
+            return true;
+        }
+        void await_suspend(std::coroutine_handle<> h) {
+            handle = h;
+            queue.pop_waiters.push_back(this);
+        }
+        T await_resume() { return std::move(*value); }
+    };
+
+    PushAwaiter push(T item) { return PushAwaiter{*this, std::move(item), {}}; }
+    PopAwaiter pop() { return PopAwaiter{*this, std::nullopt, {}}; }
+
+    std::size_t size() const { return items.size(); }
+
+private:
+    // Al quedar hueco, el primer productor suspendido deja su elemento y se reanuda
+    void admit_waiting_producer() {
+        if (push_waiters.empty()) {
+            return;
+        }
+        PushAwaiter* waiter = push_waiters.front();
+        push_waiters.pop_front();
+        items.push_back(std::move(waiter->item));
+        loop.schedule(waiter->handle);
+    }
+
+    EventLoop& loop;
+    std::size_t capacity;
+    std::deque<T> items;
+    std::deque<PushAwaiter*> push_waiters;
+    std::deque<PopAwaiter*> pop_waiters;
+};
+
+#endif  // COROUTINE_EVENT_LOOP_H
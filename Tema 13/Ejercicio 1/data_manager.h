@@ -0,0 +1,784 @@
+#ifndef DATA_MANAGER_H
+#define DATA_MANAGER_H
+
+#include <thread>
+#include <iostream>
+#include <atomic>
+#include <memory>
+#include <cstdint>
+#include <vector>
+#include <optional>
+#include <chrono>
+#include <limits>
+#include <algorithm>
+#include <filesystem>
+#include <span>
+#include <string>
+#include <stdexcept>
+
+#include "../comun/clock.h"
+#include "../comun/latency_histogram.h"
+#include "sample.h"
+#include "simulated_devices.h"
+#include "spsc_ring_buffer.h"
+#include "clock_wait.h"
+#include "periodic_sampler.h"
+#include "sample_spool.h"
+#include "send_on_delta.h"
+#include "metrics.h"
+#include "thread_config.h"
+
+// Límites para agrupar varias muestras en una única trama LoRaWAN
+struct BatchConfig {
+    std::size_t max_samples = 1;  // 1 = sin agrupación, cada muestra se envía por separado
+    std::size_t max_payload_bytes = 222;  // Carga útil máxima de la trama (una muestra mayor se descarta)
+    std::chrono::milliseconds max_added_latency{0};  // Tiempo máximo que se retiene la primera muestra
+};
+
+// Qué hacer cuando un lector produce más rápido de lo que se envía y su cola se llena
+enum class OverloadPolicy {
+    Block,           // El lector espera a que haya hueco
+    DropNewest,      // Se descarta la muestra recién leída
+    DropOldest,      // Se descarta la muestra más antigua de la cola
+    CoalesceLatest,  // Se guarda solo la última lectura del sensor hasta que haya hueco
+    SpillToDisk      // Se guarda en el spool en disco del sensor y se envía cuando la radio se recupera
+};
+
+// Configuración de DataManager
+struct DataManagerConfig {
+    BatchConfig batch;
+    OverloadPolicy overload_policy = OverloadPolicy::Block;
+    bool print_stats_on_stop = true;  // Volcar por consola en stop() el muestreo, la supresión y las latencias
+    float alarm_threshold = std::numeric_limits<float>::infinity();  // Lecturas a partir de este valor son alarmas
+    Clock* clock = &real_time_clock();  // Reloj para sellos de tiempo, plazos y esperas
+    // Periodo de muestreo de cada sensor; 0 = leer sin pausa, una lectura tras otra
+    std::chrono::milliseconds sample_period{0};
+    // Periodos propios de algunos sensores, en el orden de los lectores; los que falten usan 'sample_period'
+    std::vector<std::chrono::milliseconds> sensor_sample_periods;
+    // Envío por cambio: umbrales comunes y, como con los periodos, los propios de algunos sensores
+    DeltaConfig send_on_delta;
+    std::vector<DeltaConfig> sensor_send_on_delta;
+    // SpillToDisk: carpeta con un fichero de spool por sensor y capacidad de cada uno en muestras
+    std::string spool_directory = "spool";
+    std::size_t spool_capacity = 1 << 16;
+    // Publicación de métricas en vivo (fichero y/o socket Unix); desactivada por defecto
+    MetricsExportConfig metrics;
+    // Núcleos y planificación de los hilos de lectura y de transmisión; cada hilo los aplica al arrancar
+    ThreadConfig sensor_threads;
+    ThreadConfig transmit_threads;
+    bool lock_memory = false;  // mlockall en start(): sin fallos de página en el camino crítico
+};
+
+// Contadores de sobrecarga (copia en un instante dado)
+struct OverloadStats {
+    std::size_t blocked = 0;    // Veces que un lector tuvo que esperar hueco
+    std::size_t dropped = 0;    // Muestras descartadas
+    std::size_t coalesced = 0;  // Muestras sustituidas por una lectura más reciente del mismo sensor
+    std::size_t spooled = 0;    // Muestras guardadas en disco a la espera de la radio
+};
+
+// Histogramas de latencia del recorrido sensor -> gateway (copia en un instante dado)
+struct LatencyStats {
+    HistogramSnapshot queue_wait;  // Desde la captura hasta que empieza su envío
+    HistogramSnapshot send;        // Duración de cada envío (muestra o trama)
+    HistogramSnapshot total;       // Desde la captura hasta que termina su envío
+    HistogramSnapshot alarm_total; // Latencia total de las alarmas
+};
+
+// Clase que maneja la concurrencia y sincronización entre la lectura y el envío de datos.
+// Cada lector de sensores tiene su propio hilo y su propia cola; cada transmisor tiene un hilo
+// trabajador que atiende primero sus colas asignadas y, si están vacías, roba muestras de las demás.
+// Las alarmas van por un carril aparte que se atiende antes que cualquier cola ordinaria.
+class DataManager {
+public:
+    // Hace falta al menos un transmisor: sin ninguno lanza std::invalid_argument
+    DataManager(std::vector<SensorReader*> readers, std::vector<LoRaWANTransmitter*> transmitters,
+                DataManagerConfig config = {})
+        : batch_config(config.batch), overload_policy(config.overload_policy),
+          print_stats_on_stop(config.print_stats_on_stop), alarm_threshold(config.alarm_threshold),
+          clock(*config.clock), clock_wait(clock), sensor_thread_config(config.sensor_threads),
+          transmit_thread_config(config.transmit_threads), lock_memory(config.lock_memory),
+          metrics_exporter([this](std::ostream& out) { write_metrics(out); }, config.metrics),
+          stop_flag(false) {
+        if (transmitters.empty()) {
+            throw std::invalid_argument("DataManager necesita al menos un transmisor");
+        }
+        work_available.use_external_wait(clock_wait.for_queues());
+        for (SensorReader* reader : readers) {
+            std::size_t index = lanes.size();
+            auto period = index < config.sensor_sample_periods.size() ? config.sensor_sample_periods[index]
+                                                                       : config.sample_period;
+            DeltaConfig delta = index < config.sensor_send_on_delta.size() ? config.sensor_send_on_delta[index]
+                                                                            : config.send_on_delta;
+            lanes.push_back(std::make_unique<ProducerLane>(static_cast<std::uint32_t>(index), *reader, clock, period, delta));
+            lanes.back()->queue.use_external_wait(clock_wait.for_queues());
+            lanes.back()->alarm_queue.use_external_wait(clock_wait.for_queues());
+            if (overload_policy == OverloadPolicy::SpillToDisk) {
+                std::filesystem::create_directories(config.spool_directory);
+                auto path = std::filesystem::path(config.spool_directory) / ("sensor_" + std::to_string(index) + ".spool");
+                lanes.back()->spool = std::make_unique<SampleSpool>(path.string(), config.spool_capacity);
+            }
+        }
+        for (LoRaWANTransmitter* transmitter : transmitters) {
+            workers.push_back(std::make_unique<TransmitWorker>(workers.size(), *transmitter));
+            workers.back()->frame.reserve(batch_config.max_samples);  // Sin reservas de memoria en régimen permanente
+            workers.back()->drained.reserve(spool_drain_batch);
+        }
+    }
+
+    DataManager(SensorReader& reader, LoRaWANTransmitter& transmitter, DataManagerConfig config = {})
+        : DataManager(std::vector<SensorReader*>{&reader}, std::vector<LoRaWANTransmitter*>{&transmitter}, config) {}
+
+    // Método para iniciar los hilos
+    // Cada hilo aplica su configuración (núcleos y planificación) antes de empezar a trabajar. Si no se puede
+    // (por ejemplo, SCHED_FIFO sin privilegios), se avisa una vez por std::cerr y sigue con la planificación
+    // por defecto
+    void start() {
+        if (lock_memory) {
+            memory_locked = lock_process_memory();
+            if (!memory_locked) {
+                std::cerr << "Aviso: no se pudo bloquear la memoria del proceso (mlockall)" << std::endl;
+            }
+        }
+        for (auto& lane : lanes) {
+            lane->thread = start_clocked_thread(clock, &DataManager::sensor_task, this, std::ref(*lane));
+        }
+        for (auto& worker : workers) {
+            worker->thread = start_clocked_thread(clock, &DataManager::transmit_task, this, std::ref(*worker));
+        }
+        metrics_exporter.start();
+    }
+
+    // Método para detener los hilos y limpiar los recursos
+    void stop() {
+        stop_flag = true;  // Señal para detener las tareas
+        for (auto& lane : lanes) {
+            lane->sampler.stop();  // Sin esperar al siguiente instante de muestreo
+            lane->queue.close();  // Despertar a los lectores que estén esperando hueco
+            lane->alarm_queue.close();
+        }
+        work_available.notify();  // Despertar a los transmisores que estén esperando datos
+        for (auto& lane : lanes) {
+            join_clocked_thread(clock, lane->thread);
+        }
+        for (auto& worker : workers) {
+            join_clocked_thread(clock, worker->thread);
+        }
+        spool_unsent();
+        metrics_exporter.stop();
+        if (memory_locked) {
+            unlock_process_memory();
+            memory_locked = false;
+        }
+        if (print_stats_on_stop) {
+            print_sampling_stats(std::cout);
+            print_suppression_stats(std::cout);
+            print_latency_stats(std::cout);
+        }
+    }
+
+    // Histogramas de latencia; se pueden consultar mientras el sistema está en marcha
+    LatencyStats latency_stats() const {
+        return {queue_wait_latency.snapshot(), send_latency.snapshot(), total_latency.snapshot(),
+                alarm_latency.snapshot()};
+    }
+
+    void print_latency_stats(std::ostream& out) const {
+        LatencyStats stats = latency_stats();
+        print_histogram(out, "Espera en cola", stats.queue_wait);
+        print_histogram(out, "Envío", stats.send);
+        print_histogram(out, "Latencia total", stats.total);
+        print_histogram(out, "Latencia alarmas", stats.alarm_total);
+    }
+
+    // Regularidad del muestreo de cada sensor, en el orden de los lectores
+    std::vector<SamplingStats> sampling_stats() const {
+        std::vector<SamplingStats> stats;
+        for (const auto& lane : lanes) {
+            stats.push_back(lane->sampler.stats());
+        }
+        return stats;
+    }
+
+    void print_sampling_stats(std::ostream& out) const {
+        for (const auto& lane : lanes) {
+            ::print_sampling_stats(out, "Muestreo sensor " + std::to_string(lane->sensor_id), lane->sampler.stats());
+        }
+    }
+
+    // Lecturas enviadas y suprimidas por el envío por cambio de cada sensor, en el orden de los lectores
+    std::vector<SuppressionStats> suppression_stats() const {
+        std::vector<SuppressionStats> stats;
+        for (const auto& lane : lanes) {
+            stats.push_back(lane->delta_filter.stats());
+        }
+        return stats;
+    }
+
+    void print_suppression_stats(std::ostream& out) const {
+        for (const auto& lane : lanes) {
+            ::print_suppression_stats(out, "Cambio sensor " + std::to_string(lane->sensor_id), lane->delta_filter.stats());
+        }
+    }
+
+    // Copia de las métricas en formato de texto de Prometheus. Solo lee contadores atómicos e índices
+    // de las colas: se puede llamar en cualquier momento sin frenar a los lectores ni a los transmisores.
+    // No guarda nada entre consultas, así que varios consumidores no se estorban: los ritmos se calculan
+    // en Prometheus a partir de los contadores, por ejemplo rate(datamanager_samples_read_total[1m])
+    void write_metrics(std::ostream& out) const {
+        PrometheusWriter metrics(out);
+        std::uint64_t reads = 0;
+        for (const auto& lane : lanes) {
+            reads += lane->samples_read.load(std::memory_order_relaxed);
+        }
+        std::uint64_t sent = samples_sent.load(std::memory_order_relaxed);
+
+        metrics.counter("datamanager_samples_read_total", "Lecturas de sensores", reads);
+        metrics.counter("datamanager_samples_sent_total", "Muestras entregadas a las radios", sent);
+        metrics.counter("datamanager_sends_total", "Envíos por radio (muestras sueltas o tramas)",
+                        sends.load(std::memory_order_relaxed));
+        metrics.counter("datamanager_dropped_total", "Muestras descartadas por sobrecarga",
+                        dropped_samples.load(std::memory_order_relaxed));
+        metrics.counter("datamanager_coalesced_total", "Muestras sustituidas por una lectura más reciente",
+                        coalesced_samples.load(std::memory_order_relaxed));
+        metrics.counter("datamanager_blocked_pushes_total", "Veces que un lector esperó hueco en su cola",
+                        blocked_pushes.load(std::memory_order_relaxed));
+        metrics.counter("datamanager_spooled_total", "Muestras guardadas en el spool en disco",
+                        spooled_samples.load(std::memory_order_relaxed));
+        metrics.counter("datamanager_steals_total", "Muestras tomadas de la cola de otro transmisor",
+                        steals.load(std::memory_order_relaxed));
+
+        auto per_lane = [&](std::string_view name, std::string_view type, std::string_view help, auto value_of) {
+            metrics.family(name, type, help);
+            for (const auto& lane : lanes) {
+                metrics.value(name, value_of(*lane), "sensor=\"" + std::to_string(lane->sensor_id) + "\"");
+            }
+        };
+        per_lane("datamanager_queue_depth", "gauge", "Muestras en la cola del sensor",
+                 [](const ProducerLane& lane) { return lane.queue.size(); });
+        per_lane("datamanager_queue_high_water", "gauge", "Máximo de muestras que ha llegado a tener la cola",
+                 [](const ProducerLane& lane) { return lane.queue_high_water.load(std::memory_order_relaxed); });
+        per_lane("datamanager_alarm_queue_depth", "gauge", "Alarmas en la cola prioritaria del sensor",
+                 [](const ProducerLane& lane) { return lane.alarm_queue.size(); });
+        per_lane("datamanager_spool_backlog", "gauge", "Muestras pendientes en el spool en disco",
+                 [](const ProducerLane& lane) { return lane.spool ? lane.spool->size() : 0; });
+        per_lane("datamanager_sensor_reads_total", "counter", "Lecturas del sensor",
+                 [](const ProducerLane& lane) { return lane.samples_read.load(std::memory_order_relaxed); });
+        per_lane("datamanager_suppressed_total", "counter", "Lecturas suprimidas por el envío por cambio",
+                 [](const ProducerLane& lane) { return lane.delta_filter.stats().suppressed; });
+        per_lane("datamanager_lock_wait_seconds_total", "counter", "Tiempo esperando el lado consumidor de la cola",
+                 [](const ProducerLane& lane) { return lane.lock_wait_ns.load(std::memory_order_relaxed) / 1e9; });
+    }
+
+    // Muestras guardadas en disco pendientes de envío (SpillToDisk), incluidas las de ejecuciones anteriores
+    std::size_t spool_backlog() const {
+        std::size_t backlog = 0;
+        for (const auto& lane : lanes) {
+            backlog += lane->spool ? lane->spool->size() : 0;
+        }
+        return backlog;
+    }
+
+    // Muestras que un transmisor ha tomado de una cola que no era la suya
+    std::size_t stolen_count() const { return steals.load(std::memory_order_relaxed); }
+
+    OverloadStats overload_stats() const {
+        OverloadStats stats;
+        stats.blocked = blocked_pushes.load(std::memory_order_relaxed);
+        stats.dropped = dropped_samples.load(std::memory_order_relaxed);
+        stats.coalesced = coalesced_samples.load(std::memory_order_relaxed);
+        stats.spooled = spooled_samples.load(std::memory_order_relaxed);
+        return stats;
+    }
+
+private:
+    static constexpr std::size_t lane_capacity = 64;
+    static constexpr std::size_t alarm_lane_capacity = 16;
+    static constexpr std::size_t spool_drain_batch = 32;  // Muestras que un transmisor saca del spool de una vez
+    static constexpr int lock_spin_rounds = 16;  // Búsquedas fallidas por colas ocupadas antes de empezar a dormir
+
+    // Cola de un único lector (un sensor). Varios transmisores pueden extraer de ella, pero nunca a la vez:
+    // 'consumer_lock' mantiene la cola como SPSC. El lector solo lo toma cuando la cola se llena y
+    // la política de sobrecarga le obliga a tocar el lado del consumidor
+    struct ProducerLane {
+        ProducerLane(std::uint32_t sensor_id, SensorReader& reader, Clock& clock, Clock::duration sample_period,
+                     DeltaConfig delta)
+            : sensor_id(sensor_id), reader(reader), sampler(clock, sample_period), delta_filter(delta) {}
+
+        std::uint32_t sensor_id;
+        SensorReader& reader;
+        PeriodicSampler sampler;  // Instantes de lectura a ritmo fijo
+        DeltaFilter delta_filter;  // Descarta lecturas que apenas cambian antes de que ocupen cola y radio
+        SpscRingBuffer<Sample, lane_capacity> queue;
+        SpscRingBuffer<Sample, alarm_lane_capacity> alarm_queue;  // Carril prioritario: nunca descarta
+        std::atomic_flag consumer_lock = ATOMIC_FLAG_INIT;
+        std::optional<Sample> latest;  // Última lectura pendiente (CoalesceLatest), protegida por consumer_lock
+        std::atomic<bool> has_latest{false};
+        // Spool en disco (SpillToDisk). Mientras tenga muestras, las nuevas van detrás de ellas y no a la cola,
+        // así se envían en orden de captura. Su lado consumidor también se protege con consumer_lock
+        std::unique_ptr<SampleSpool> spool;
+        // Un transmisor tiene un bloque del spool sin confirmar: nadie más lo lee hasta que lo confirme entero
+        std::atomic<bool> spool_claimed{false};
+        std::atomic<std::uint64_t> samples_read{0};
+        std::atomic<std::size_t> queue_high_water{0};  // Solo lo escribe el lector
+        std::atomic<std::uint64_t> lock_wait_ns{0};    // Tiempo esperando consumer_lock
+        std::thread thread;
+    };
+
+    // Toma el lado consumidor de una cola esperando de forma activa: solo se retiene durante una extracción.
+    // Si tiene que esperar, suma el tiempo real de espera a las métricas de la cola
+    class ConsumerLockGuard {
+    public:
+        explicit ConsumerLockGuard(ProducerLane& lane) : lane(lane) {
+            if (!lane.consumer_lock.test_and_set(std::memory_order_acquire)) {
+                return;
+            }
+            auto wait_start = std::chrono::steady_clock::now();
+            while (lane.consumer_lock.test_and_set(std::memory_order_acquire)) {
+                std::this_thread::yield();
+            }
+            auto waited = std::chrono::steady_clock::now() - wait_start;
+            lane.lock_wait_ns.fetch_add(std::chrono::duration_cast<std::chrono::nanoseconds>(waited).count(),
+                                        std::memory_order_relaxed);
+        }
+        ~ConsumerLockGuard() { lane.consumer_lock.clear(std::memory_order_release); }
+
+    private:
+        ProducerLane& lane;
+    };
+
+    // Estado de un hilo transmisor (solo lo toca su propio hilo)
+    struct TransmitWorker {
+        TransmitWorker(std::size_t index, LoRaWANTransmitter& transmitter) : index(index), transmitter(transmitter) {}
+
+        std::size_t index;
+        LoRaWANTransmitter& transmitter;
+        std::size_t next_lane = 0;  // Reparto circular entre las colas
+        std::vector<Sample> frame;  // Trama en construcción
+        std::optional<Sample> carried_sample;  // Muestra que no cupo en la trama anterior
+        // Bloque leído del spool de 'drained_lane'. Solo se confirma en el spool lo ya enviado: si el proceso
+        // cae antes, esas muestras siguen en disco
+        std::vector<Sample> drained;
+        std::size_t drained_next = 0;       // Siguiente muestra del bloque por entregar
+        std::size_t drained_committed = 0;  // Muestras del bloque ya enviadas y confirmadas
+        ProducerLane* drained_lane = nullptr;
+        bool last_from_spool = false;  // La última muestra que entregó try_take salió del bloque
+        bool saw_locked_lane = false;  // La última búsqueda se saltó alguna cola porque la vaciaba otro transmisor
+        std::thread thread;
+    };
+
+    BatchConfig batch_config;
+    OverloadPolicy overload_policy;
+    bool print_stats_on_stop;
+    float alarm_threshold;
+    Clock& clock;
+    ClockWait clock_wait;  // Las esperas de las colas pasan por el reloj si es simulado
+    ThreadConfig sensor_thread_config;
+    ThreadConfig transmit_thread_config;
+    bool lock_memory;
+    bool memory_locked = false;
+    std::atomic<bool> sensor_config_warned{false};
+    std::atomic<bool> transmit_config_warned{false};
+    std::vector<std::unique_ptr<ProducerLane>> lanes;
+    std::vector<std::unique_ptr<TransmitWorker>> workers;
+    WaitPoint work_available;  // Avisa a los transmisores de que alguna cola tiene datos
+    std::atomic<std::size_t> steals{0};
+    std::atomic<std::size_t> blocked_pushes{0};
+    std::atomic<std::size_t> dropped_samples{0};
+    std::atomic<std::size_t> coalesced_samples{0};
+    std::atomic<std::size_t> spooled_samples{0};
+    std::atomic<std::uint64_t> samples_sent{0};
+    std::atomic<std::uint64_t> sends{0};
+    MetricsExporter metrics_exporter;
+    std::atomic<std::size_t> pending_alarms{0};  // Permite saltarse la búsqueda de alarmas si no hay ninguna
+    LatencyHistogram queue_wait_latency;
+    LatencyHistogram send_latency;
+    LatencyHistogram total_latency;
+    LatencyHistogram alarm_latency;
+    std::atomic<bool> stop_flag;
+
+    // Aplica la configuración al hilo que llama, al principio de su tarea: rige desde su primera lectura
+    // o envío. Si falla, avisa solo el primer hilo de cada tipo
+    static void configure_this_thread(const ThreadConfig& config, std::atomic<bool>& warned, const char* role) {
+        if (config.is_default() || apply_thread_config(config).ok()) {
+            return;
+        }
+        if (!warned.exchange(true)) {
+            std::cerr << "Aviso: no se pudo aplicar la configuración de los hilos de " << role << std::endl;
+        }
+    }
+
+    // Tarea del hilo que lee datos de un sensor
+    void sensor_task(ProducerLane& lane) {
+        configure_this_thread(sensor_thread_config, sensor_config_warned, "lectura");
+        lane.sampler.start();
+        while (!stop_flag) {
+            // Plazo absoluto: el tiempo de lectura y encolado no desplaza el periodo
+            if (!lane.sampler.wait_next() || stop_flag) {
+                break;
+            }
+            SensorReading reading = lane.reader.read_sensor_data();
+            Sample sample;
+            sample.set_data(reading.data);
+            sample.captured_at = clock.now();  // Sello de captura
+            sample.sensor_id = lane.sensor_id;
+            sample.value = reading.value;
+            sample.priority = reading.value >= alarm_threshold ? Priority::Alarm : Priority::Routine;
+            lane.samples_read.fetch_add(1, std::memory_order_relaxed);
+            if (!lane.delta_filter.admit(sample)) {
+                continue;  // Apenas ha cambiado: ni ocupa cola ni tiempo de radio
+            }
+            EnqueueResult result = enqueue(lane, sample);
+            if (result == EnqueueResult::Closed) {
+                break;
+            }
+            if (result == EnqueueResult::Queued) {
+                lane.delta_filter.commit(sample);  // Una lectura descartada no sirve de referencia
+            }
+            std::size_t depth = lane.queue.size();
+            if (depth > lane.queue_high_water.load(std::memory_order_relaxed)) {
+                lane.queue_high_water.store(depth, std::memory_order_relaxed);
+            }
+            work_available.notify();
+        }
+    }
+
+    // Resultado de insertar una muestra: guardada camino de la radio (en la cola o en el spool), descartada
+    // por sobrecarga, o no guardada porque la cola se ha cerrado
+    enum class EnqueueResult { Queued, Dropped, Closed };
+
+    // Inserta una muestra aplicando la política de sobrecarga
+    EnqueueResult enqueue(ProducerLane& lane, Sample data) {
+        if (data.priority == Priority::Alarm) {
+            pending_alarms.fetch_add(1);  // Antes de insertar: un transmisor puede buscarla en vano, pero nunca pasarla por alto
+            if (!lane.alarm_queue.push_wait(std::move(data))) {
+                pending_alarms.fetch_sub(1);  // No llegó a la cola: nadie la va a sacar
+                return EnqueueResult::Closed;
+            }
+            return EnqueueResult::Queued;
+        }
+        if (!lane.has_latest.load(std::memory_order_acquire) && !(lane.spool && !lane.spool->empty()) &&
+            lane.queue.try_push(std::move(data))) {
+            return EnqueueResult::Queued;  // Camino rápido: había hueco
+        }
+
+        switch (overload_policy) {
+        case OverloadPolicy::Block:
+            blocked_pushes.fetch_add(1, std::memory_order_relaxed);
+            // Espera si la cola está llena
+            return lane.queue.push_wait(std::move(data)) ? EnqueueResult::Queued : EnqueueResult::Closed;
+
+        case OverloadPolicy::DropNewest:
+            dropped_samples.fetch_add(1, std::memory_order_relaxed);
+            return EnqueueResult::Dropped;
+
+        case OverloadPolicy::DropOldest: {
+            Sample oldest;
+            ConsumerLockGuard lock(lane);
+            while (!lane.queue.try_push(std::move(data))) {
+                if (lane.queue.try_pop(oldest)) {
+                    dropped_samples.fetch_add(1, std::memory_order_relaxed);
+                }
+            }
+            return EnqueueResult::Queued;
+        }
+
+        case OverloadPolicy::CoalesceLatest: {
+            ConsumerLockGuard lock(lane);
+            if (lane.latest && lane.queue.try_push(std::move(*lane.latest))) {
+                lane.latest.reset();  // La lectura pendiente ya cabe en la cola
+            }
+            if (!lane.latest && lane.queue.try_push(std::move(data))) {
+                lane.has_latest.store(false, std::memory_order_release);
+                return EnqueueResult::Queued;
+            }
+            if (lane.latest) {
+                coalesced_samples.fetch_add(1, std::memory_order_relaxed);
+            }
+            lane.latest = std::move(data);  // Sustituye a la lectura pendiente anterior
+            lane.has_latest.store(true, std::memory_order_release);
+            return EnqueueResult::Queued;
+        }
+
+        case OverloadPolicy::SpillToDisk:
+            if (lane.spool->try_push(data)) {
+                spooled_samples.fetch_add(1, std::memory_order_relaxed);
+                return EnqueueResult::Queued;
+            }
+            dropped_samples.fetch_add(1, std::memory_order_relaxed);  // Ni la cola ni el disco tienen hueco
+            return EnqueueResult::Dropped;
+        }
+        return EnqueueResult::Closed;
+    }
+
+    // Tarea del hilo que envía los datos al gateway LoRaWAN
+    void transmit_task(TransmitWorker& worker) {
+        configure_this_thread(transmit_thread_config, transmit_config_warned, "transmisión");
+        Sample data_to_send;
+        while (!stop_flag) {
+            if (worker.carried_sample) {
+                data_to_send = std::move(*worker.carried_sample);
+                worker.carried_sample.reset();
+            } else if (!wait_for_sample(worker, data_to_send, std::nullopt)) {  // Espera hasta que haya datos o se detenga
+                break;
+            }
+
+            if (batch_config.max_samples <= 1) {
+                auto send_start = clock.now();
+                worker.transmitter.send_data(data_to_send);  // Enviar los datos
+                record_latency(data_to_send, send_start, clock.now());
+                commit_spooled(worker);
+            } else {
+                transmit_batch(worker, std::move(data_to_send));
+            }
+        }
+        // La muestra que no cupo en la última trama ya salió de su cola: se envía antes de terminar
+        while (worker.carried_sample) {
+            Sample carried = std::move(*worker.carried_sample);
+            worker.carried_sample.reset();
+            transmit_batch(worker, std::move(carried));
+        }
+    }
+
+    // Agrupa muestras a partir de 'first' hasta llenar la trama o agotar la latencia añadida y la envía
+    // Si la trama lleva una alarma, se envía en cuanto se vacía lo que ya está en cola, sin esperar más.
+    // Una muestra que por sí sola no cabe en la carga útil de la trama no se puede enviar: se descarta
+    void transmit_batch(TransmitWorker& worker, Sample first) {
+        if (first.payload_size > batch_config.max_payload_bytes) {
+            dropped_samples.fetch_add(1, std::memory_order_relaxed);
+            commit_spooled(worker);  // Si venía del spool, tampoco se podrá enviar más adelante
+            return;
+        }
+        auto deadline = clock.now() + batch_config.max_added_latency;
+        if (first.priority == Priority::Alarm) {
+            deadline = clock.now();
+        }
+        std::size_t payload_bytes = first.payload_size;
+        worker.frame.clear();
+        worker.frame.push_back(std::move(first));
+
+        Sample next;
+        while (worker.frame.size() < batch_config.max_samples && wait_for_sample(worker, next, deadline)) {
+            if (payload_bytes + next.payload_size > batch_config.max_payload_bytes) {
+                // Irá al principio de la siguiente trama. Si viene del spool, se devuelve al bloque: así solo
+                // se confirma cuando de verdad se envíe
+                if (worker.last_from_spool) {
+                    --worker.drained_next;
+                } else {
+                    worker.carried_sample = std::move(next);
+                }
+                break;
+            }
+            payload_bytes += next.payload_size;
+            if (next.priority == Priority::Alarm) {
+                deadline = std::min(deadline, clock.now());
+            }
+            worker.frame.push_back(std::move(next));
+        }
+
+        auto send_start = clock.now();
+        worker.transmitter.send_frame(worker.frame, payload_bytes);
+        auto send_end = clock.now();
+        commit_spooled(worker);
+        sends.fetch_add(1, std::memory_order_relaxed);
+        samples_sent.fetch_add(worker.frame.size(), std::memory_order_relaxed);
+        send_latency.record(send_end - send_start);
+        for (const Sample& sample : worker.frame) {
+            record_sample_latency(sample, send_start, send_end);
+        }
+    }
+
+    void record_latency(const Sample& sample, Clock::time_point send_start,
+                        Clock::time_point send_end) {
+        sends.fetch_add(1, std::memory_order_relaxed);
+        samples_sent.fetch_add(1, std::memory_order_relaxed);
+        send_latency.record(send_end - send_start);
+        record_sample_latency(sample, send_start, send_end);
+    }
+
+    void record_sample_latency(const Sample& sample, Clock::time_point send_start,
+                               Clock::time_point send_end) {
+        queue_wait_latency.record(send_start - sample.captured_at);
+        total_latency.record(send_end - sample.captured_at);
+        if (sample.priority == Priority::Alarm) {
+            alarm_latency.record(send_end - sample.captured_at);
+        }
+    }
+
+    // Espera una muestra de cualquier cola. Devuelve false si se alcanza 'deadline' o se detiene el sistema
+    bool wait_for_sample(TransmitWorker& worker, Sample& sample,
+                         std::optional<Clock::time_point> deadline) {
+        auto nothing_to_send = [this] { return all_lanes_empty() && !stop_flag; };
+        int busy_rounds = 0;
+        while (!try_take(worker, sample)) {
+            if (stop_flag) {
+                return false;
+            }
+            if (worker.saw_locked_lane) {
+                // Hay datos, pero en colas que está vaciando otro transmisor: esperar no serviría (las colas
+                // no están vacías) y reintentar sin pausa solo le quitaría CPU. Primero se cede y después se duerme
+                if (deadline && clock.now() >= *deadline) {
+                    return false;
+                }
+                back_off(busy_rounds++);
+                continue;
+            }
+            busy_rounds = 0;
+            if (!deadline) {
+                work_available.wait_while(nothing_to_send);
+            } else if (!work_available.wait_while_until(*deadline, nothing_to_send)) {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    // Pausa creciente entre búsquedas que solo encuentran colas ocupadas: unas cuantas cesiones de CPU
+    // y luego esperas que se doblan hasta 64 us
+    void back_off(int round) {
+        if (round < lock_spin_rounds) {
+            std::this_thread::yield();
+        } else {
+            clock.sleep_for(std::chrono::microseconds(1 << std::min(round - lock_spin_rounds, 6)));
+        }
+    }
+
+    // Intenta extraer una muestra: primero alarmas, luego de las colas asignadas al trabajador y después del resto
+    bool try_take(TransmitWorker& worker, Sample& sample) {
+        worker.saw_locked_lane = false;
+        worker.last_from_spool = false;
+        if (pending_alarms.load() > 0 && try_take_alarm(worker, sample)) {
+            return true;
+        }
+        if (worker.drained_next < worker.drained.size()) {
+            sample = worker.drained[worker.drained_next++];
+            worker.last_from_spool = true;
+            return true;
+        }
+
+        const std::size_t lane_count = lanes.size();
+        for (bool stealing : {false, true}) {
+            for (std::size_t offset = 0; offset < lane_count; ++offset) {
+                std::size_t lane_index = (worker.next_lane + offset) % lane_count;
+                bool own_lane = lane_index % workers.size() == worker.index;
+                if (own_lane == stealing) {
+                    continue;
+                }
+                ProducerLane& lane = *lanes[lane_index];
+                if (lane.consumer_lock.test_and_set(std::memory_order_acquire)) {
+                    worker.saw_locked_lane = true;  // Otro transmisor la está vaciando
+                    continue;
+                }
+                bool taken = lane.queue.try_pop(sample) || take_latest(lane, sample) ||
+                             take_spooled(worker, lane, sample);
+                if (!taken && lane.spool_claimed.load(std::memory_order_acquire)) {
+                    worker.saw_locked_lane = true;  // Su spool lo está enviando otro transmisor
+                }
+                lane.consumer_lock.clear(std::memory_order_release);
+                if (taken) {
+                    worker.next_lane = lane_index + 1;
+                    if (stealing) {
+                        steals.fetch_add(1, std::memory_order_relaxed);
+                    }
+                    return true;
+                }
+            }
+        }
+        return false;
+    }
+
+    bool try_take_alarm(TransmitWorker& worker, Sample& sample) {
+        const std::size_t lane_count = lanes.size();
+        for (std::size_t offset = 0; offset < lane_count; ++offset) {
+            ProducerLane& lane = *lanes[(worker.index + offset) % lane_count];
+            if (lane.consumer_lock.test_and_set(std::memory_order_acquire)) {
+                worker.saw_locked_lane = true;
+                continue;
+            }
+            bool taken = lane.alarm_queue.try_pop(sample);
+            lane.consumer_lock.clear(std::memory_order_release);
+            if (taken) {
+                pending_alarms.fetch_sub(1);
+                return true;
+            }
+        }
+        return false;
+    }
+
+    // Con la cola ya vacía, entrega la lectura pendiente de CoalesceLatest (requiere consumer_lock)
+    static bool take_latest(ProducerLane& lane, Sample& sample) {
+        if (!lane.has_latest.load(std::memory_order_acquire) || !lane.latest) {
+            return false;
+        }
+        sample = std::move(*lane.latest);
+        lane.latest.reset();
+        lane.has_latest.store(false, std::memory_order_release);
+        return true;
+    }
+
+    // Con la cola ya vacía, lee del spool un bloque de muestras sin sacarlas (requiere consumer_lock).
+    // Entrega la primera; el resto queda en el trabajador y sale en las siguientes llamadas a try_take.
+    // Un trabajador solo tiene un bloque a la vez, y un spool solo lo lee un trabajador a la vez
+    static bool take_spooled(TransmitWorker& worker, ProducerLane& lane, Sample& sample) {
+        if (!lane.spool || worker.drained_lane || lane.spool_claimed.load(std::memory_order_relaxed)) {
+            return false;
+        }
+        worker.drained.resize(spool_drain_batch);  // Dentro de la capacidad reservada: no reserva memoria
+        worker.drained.resize(lane.spool->peek_bulk(std::span<Sample>(worker.drained)));
+        worker.drained_next = 0;
+        worker.drained_committed = 0;
+        if (worker.drained.empty()) {
+            return false;
+        }
+        lane.spool_claimed.store(true, std::memory_order_relaxed);
+        worker.drained_lane = &lane;
+        sample = worker.drained[worker.drained_next++];
+        worker.last_from_spool = true;
+        return true;
+    }
+
+    // Tras un envío, confirma en el spool las muestras del bloque que ya han salido. Con el bloque
+    // entero confirmado, el spool queda libre para el siguiente trabajador
+    static void commit_spooled(TransmitWorker& worker) {
+        if (!worker.drained_lane || worker.drained_next == worker.drained_committed) {
+            return;
+        }
+        worker.drained_lane->spool->commit(worker.drained_next - worker.drained_committed);
+        worker.drained_committed = worker.drained_next;
+        if (worker.drained_committed == worker.drained.size()) {
+            worker.drained_lane->spool_claimed.store(false, std::memory_order_release);
+            worker.drained_lane = nullptr;
+        }
+    }
+
+    // SpillToDisk: al parar, lo que queda en las colas en memoria se guarda en el spool y se envía en la
+    // siguiente ejecución. Va detrás de lo que ya estaba en disco, así que esas muestras pierden el orden
+    // de captura. Se llama con todos los hilos parados
+    void spool_unsent() {
+        Sample sample;
+        for (auto& lane : lanes) {
+            if (!lane->spool) {
+                continue;
+            }
+            while (lane->alarm_queue.try_pop(sample) || lane->queue.try_pop(sample)) {
+                if (lane->spool->try_push(sample)) {
+                    spooled_samples.fetch_add(1, std::memory_order_relaxed);
+                } else {
+                    dropped_samples.fetch_add(1, std::memory_order_relaxed);
+                }
+            }
+        }
+    }
+
+    bool all_lanes_empty() const {
+        for (const auto& lane : lanes) {
+            if (!lane->queue.empty() || !lane->alarm_queue.empty() || lane->has_latest.load() ||
+                (lane->spool && !lane->spool->empty())) {
+                return false;
+            }
+        }
+        return true;
+    }
+};
+
+#endif  // DATA_MANAGER_H
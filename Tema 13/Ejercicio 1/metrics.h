@@ -0,0 +1,198 @@
+#ifndef METRICS_H
+#define METRICS_H
+
+#include <algorithm>
+#include <atomic>
+#include <cerrno>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <fstream>
+#include <functional>
+#include <sstream>
+#include <string>
+#include <string_view>
+#include <system_error>
+#include <thread>
+
+#include <poll.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <unistd.h>
+
+// Escribe métricas en el formato de texto de Prometheus:
+//     # HELP datamanager_samples_read_total Lecturas de sensores
+//     # TYPE datamanager_samples_read_total counter
+//     datamanager_samples_read_total{sensor="0"} 42
+class PrometheusWriter {
+public:
+    explicit PrometheusWriter(std::ostream& out) : out(out) {}
+
+    // Cabecera de una familia de métricas; después se escriben sus valores con value()
+    void family(std::string_view name, std::string_view type, std::string_view help) {
+        out << "# HELP " << name << ' ' << help << '\n' << "# TYPE " << name << ' ' << type << '\n';
+    }
+
+    // 'labels' sin llaves, por ejemplo: sensor="0"
+    template <typename Value>
+    void value(std::string_view name, Value metric_value, std::string_view labels = {}) {
+        out << name;
+        if (!labels.empty()) {
+            out << '{' << labels << '}';
+        }
+        out << ' ' << metric_value << '\n';
+    }
+
+    template <typename Value>
+    void counter(std::string_view name, std::string_view help, Value metric_value) {
+        family(name, "counter", help);
+        value(name, metric_value);
+    }
+
+    template <typename Value>
+    void gauge(std::string_view name, std::string_view help, Value metric_value) {
+        family(name, "gauge", help);
+        value(name, metric_value);
+    }
+
+private:
+    std::ostream& out;
+};
+
+// Dónde se publican las métricas. Con las dos rutas vacías no se publica nada
+struct MetricsExportConfig {
+    std::string file_path;    // Fichero que se reescribe entero en cada intervalo
+    std::string socket_path;  // Socket Unix local: cada conexión recibe una copia y se cierra
+    std::chrono::milliseconds interval{1000};  // Cada cuánto se reescribe el fichero
+};
+
+// Hilo que publica una copia de las métricas en un fichero y/o en un socket Unix.
+// Por ejemplo: socat - UNIX-CONNECT:/tmp/datamanager.sock
+// Trabaja en tiempo real aunque el sistema use un reloj simulado: observa, no participa
+class MetricsExporter {
+public:
+    MetricsExporter(std::function<void(std::ostream&)> write_snapshot, MetricsExportConfig config)
+        : write_snapshot(std::move(write_snapshot)), config(std::move(config)) {}
+
+    MetricsExporter(const MetricsExporter&) = delete;
+    MetricsExporter& operator=(const MetricsExporter&) = delete;
+
+    ~MetricsExporter() { stop(); }
+
+    bool enabled() const { return !config.file_path.empty() || !config.socket_path.empty(); }
+
+    // Lanza std::system_error si no se puede abrir el socket
+    void start() {
+        if (!enabled() || thread.joinable()) {
+            return;
+        }
+        if (!config.socket_path.empty()) {
+            open_socket();
+        }
+        stop_flag = false;
+        thread = std::thread(&MetricsExporter::run, this);
+    }
+
+    // Detiene el hilo; el fichero queda con la última copia
+    void stop() {
+        if (!thread.joinable()) {
+            return;
+        }
+        stop_flag = true;
+        thread.join();
+        if (!config.file_path.empty()) {
+            write_file();
+        }
+        if (listen_fd >= 0) {
+            ::close(listen_fd);
+            ::unlink(config.socket_path.c_str());
+            listen_fd = -1;
+        }
+    }
+
+private:
+    static constexpr std::chrono::milliseconds poll_slice{100};  // Latencia máxima de stop()
+
+    void run() {
+        auto next_file_write = std::chrono::steady_clock::now();
+        while (!stop_flag) {
+            auto now = std::chrono::steady_clock::now();
+            if (!config.file_path.empty() && now >= next_file_write) {
+                write_file();
+                next_file_write = now + config.interval;
+            }
+            auto timeout = poll_slice;
+            if (!config.file_path.empty()) {
+                timeout = std::min(timeout, std::chrono::ceil<std::chrono::milliseconds>(next_file_write - now));
+            }
+            pollfd listener{listen_fd, POLLIN, 0};
+            int ready = ::poll(listen_fd >= 0 ? &listener : nullptr, listen_fd >= 0 ? 1 : 0,
+                               static_cast<int>(std::max<std::int64_t>(timeout.count(), 0)));
+            if (ready > 0 && (listener.revents & POLLIN)) {
+                serve_connection();
+            }
+        }
+    }
+
+    std::string snapshot() const {
+        std::ostringstream text;
+        write_snapshot(text);
+        return text.str();
+    }
+
+    // Se escribe en un fichero temporal y se renombra: quien lo lea nunca ve una copia a medias
+    void write_file() {
+        std::string temporary = config.file_path + ".tmp";
+        {
+            std::ofstream file(temporary, std::ios::trunc);
+            file << snapshot();
+        }
+        std::rename(temporary.c_str(), config.file_path.c_str());
+    }
+
+    void open_socket() {
+        sockaddr_un address{};
+        address.sun_family = AF_UNIX;
+        if (config.socket_path.size() >= sizeof(address.sun_path)) {
+            throw std::system_error(ENAMETOOLONG, std::generic_category(), "Ruta de socket demasiado larga");
+        }
+        std::copy(config.socket_path.begin(), config.socket_path.end(), address.sun_path);
+        listen_fd = ::socket(AF_UNIX, SOCK_STREAM | SOCK_CLOEXEC | SOCK_NONBLOCK, 0);
+        if (listen_fd < 0) {
+            throw std::system_error(errno, std::generic_category(), "No se puede crear el socket de métricas");
+        }
+        ::unlink(config.socket_path.c_str());  // Restos de una ejecución anterior
+        if (::bind(listen_fd, reinterpret_cast<sockaddr*>(&address), sizeof(address)) != 0 ||
+            ::listen(listen_fd, 8) != 0) {
+            int error = errno;
+            ::close(listen_fd);
+            listen_fd = -1;
+            throw std::system_error(error, std::generic_category(), "No se puede escuchar en " + config.socket_path);
+        }
+    }
+
+    void serve_connection() {
+        int client = ::accept4(listen_fd, nullptr, nullptr, SOCK_CLOEXEC);
+        if (client < 0) {
+            return;
+        }
+        std::string text = snapshot();
+        std::size_t written = 0;
+        while (written < text.size()) {
+            ssize_t result = ::send(client, text.data() + written, text.size() - written, MSG_NOSIGNAL);
+            if (result <= 0) {
+                break;  // El cliente se ha ido
+            }
+            written += static_cast<std::size_t>(result);
+        }
+        ::close(client);
+    }
+
+    std::function<void(std::ostream&)> write_snapshot;
+    MetricsExportConfig config;
+    int listen_fd = -1;
+    std::atomic<bool> stop_flag{false};
+    std::thread thread;
+};
+
+#endif  // METRICS_H
@@ -0,0 +1,87 @@
+// Comprobación: las métricas de DataManager se pueden leer en vivo por un socket Unix y por fichero
+// Compilar: g++ -std=c++20 -O2 -pthread metrics_check.cpp -o metrics_check
+#include <iostream>
+#include <fstream>
+#include <sstream>
+#include <thread>
+#include <chrono>
+#include <cstdlib>
+#include <cstdio>
+#include <string>
+
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <unistd.h>
+
+#include "simulated_devices.h"
+#include "data_manager.h"
+
+// Se conecta al socket y devuelve todo lo que envía el servidor antes de cerrar
+std::string scrape(const std::string& socket_path) {
+    int fd = ::socket(AF_UNIX, SOCK_STREAM | SOCK_CLOEXEC, 0);
+    sockaddr_un address{};
+    address.sun_family = AF_UNIX;
+    socket_path.copy(address.sun_path, sizeof(address.sun_path) - 1);
+    std::string text;
+    if (fd >= 0 && ::connect(fd, reinterpret_cast<sockaddr*>(&address), sizeof(address)) == 0) {
+        char buffer[4096];
+        ssize_t received;
+        while ((received = ::recv(fd, buffer, sizeof(buffer), 0)) > 0) {
+            text.append(buffer, static_cast<std::size_t>(received));
+        }
+    }
+    if (fd >= 0) {
+        ::close(fd);
+    }
+    return text;
+}
+
+// Valor de la primera serie cuyo nombre (con etiquetas) empieza por 'series'
+double metric_value(const std::string& text, const std::string& series) {
+    std::istringstream lines(text);
+    std::string line;
+    while (std::getline(lines, line)) {
+        if (line.rfind(series + " ", 0) == 0 || line.rfind(series + "{", 0) == 0) {
+            return std::stod(line.substr(line.rfind(' ') + 1));
+        }
+    }
+    return -1.0;
+}
+
+int main() {
+    const std::string socket_path = "/tmp/datamanager_metrics_check.sock";
+    const std::string file_path = "/tmp/datamanager_metrics_check.prom";
+
+    SensorReader fast_bus(std::chrono::milliseconds(1), false);
+    SensorReader slow_bus(std::chrono::milliseconds(3), false);
+    LoRaWANTransmitter radio(std::chrono::milliseconds(5), false);
+
+    DataManagerConfig config;
+    config.overload_policy = OverloadPolicy::DropOldest;
+    config.print_stats_on_stop = false;
+    config.metrics.socket_path = socket_path;
+    config.metrics.file_path = file_path;
+    config.metrics.interval = std::chrono::milliseconds(100);
+
+    DataManager data_manager({&fast_bus, &slow_bus}, {&radio}, config);
+    data_manager.start();
+    std::this_thread::sleep_for(std::chrono::milliseconds(300));
+    std::string earlier = scrape(socket_path);  // Los contadores solo pueden crecer entre dos consultas
+    std::this_thread::sleep_for(std::chrono::milliseconds(200));
+    std::string live = scrape(socket_path);
+    data_manager.stop();
+
+    std::ifstream file(file_path);
+    std::string saved((std::istreambuf_iterator<char>(file)), std::istreambuf_iterator<char>());
+    std::remove(file_path.c_str());
+
+    std::cout << live;
+    bool ok = metric_value(live, "datamanager_samples_read_total") > 0 &&
+              metric_value(live, "datamanager_samples_read_total") >
+                  metric_value(earlier, "datamanager_samples_read_total") &&
+              metric_value(live, "datamanager_queue_high_water") > 0 &&
+              metric_value(live, "datamanager_dropped_total") > 0 &&
+              metric_value(saved, "datamanager_samples_sent_total") > 0;
+    std::cout << (ok ? "[OK]    " : "[FALLO] ") << "Métricas por socket Unix y por fichero" << std::endl;
+    return ok ? EXIT_SUCCESS : EXIT_FAILURE;
+}
@@ -0,0 +1,102 @@
+#ifndef PERIODIC_SAMPLER_H
+#define PERIODIC_SAMPLER_H
+
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <iomanip>
+#include <iostream>
+#include <string>
+
+#include "../comun/clock.h"
+#include "../comun/latency_histogram.h"
+
+// Estadísticas de un muestreo periódico (copia en un instante dado)
+struct SamplingStats {
+    Clock::duration period{};
+    std::size_t ticks = 0;             // Instantes de muestreo atendidos
+    std::size_t missed_deadlines = 0;  // Instantes que se saltaron porque el hilo llegó tarde más de un periodo
+    HistogramSnapshot jitter;          // Retraso de cada despertar respecto a su instante previsto
+};
+
+// Marca el ritmo de un muestreo periódico con plazos absolutos: el instante k es inicio + k * periodo,
+// así el tiempo de lectura, las esperas por cerrojos o los retrasos del planificador no se acumulan.
+// La espera es hasta un instante absoluto del reloj y se puede interrumpir con stop() desde otro hilo.
+// Solo lo usa un hilo (el del sensor); stop() y las estadísticas se pueden usar desde cualquier otro
+class PeriodicSampler {
+public:
+    // Un periodo nulo desactiva el muestreo periódico: wait_next() vuelve enseguida (lecturas seguidas)
+    PeriodicSampler(Clock& clock, Clock::duration period) : clock(clock), period(period) {}
+
+    // Fija el instante del primer muestreo; wait_next() vuelve en él sin esperar
+    void start() {
+        next_deadline = clock.now();
+        first_tick = true;
+    }
+
+    // Despierta al hilo si está esperando en wait_next() y hace que las siguientes llamadas vuelvan enseguida
+    void stop() {
+        stopped.store(true);
+        clock.notify_waiters();
+    }
+
+    // Espera al siguiente instante de muestreo. Si el hilo va con más de un periodo de retraso,
+    // se saltan los instantes ya pasados (sin ráfagas para recuperarlos) y se cuentan como perdidos.
+    // Devuelve false si se ha llamado a stop(): entonces no hay que leer
+    bool wait_next() {
+        if (period <= Clock::duration::zero()) {
+            return !stopped.load();
+        }
+        if (!first_tick) {
+            next_deadline += period;
+        }
+        first_tick = false;
+
+        auto late = clock.now() - next_deadline;
+        if (late >= period) {
+            auto skipped = late / period;
+            next_deadline += skipped * period;
+            missed.fetch_add(static_cast<std::size_t>(skipped), std::memory_order_relaxed);
+        }
+        // Vuelve enseguida si el instante ya ha pasado
+        if (clock.wait_until(next_deadline, [this] { return stopped.load(); })) {
+            return false;
+        }
+        jitter.record(clock.now() - next_deadline);
+        ticks.fetch_add(1, std::memory_order_relaxed);
+        return true;
+    }
+
+    SamplingStats stats() const {
+        SamplingStats copy;
+        copy.period = period;
+        copy.ticks = ticks.load(std::memory_order_relaxed);
+        copy.missed_deadlines = missed.load(std::memory_order_relaxed);
+        copy.jitter = jitter.snapshot();
+        return copy;
+    }
+
+private:
+    Clock& clock;
+    Clock::duration period;
+    Clock::time_point next_deadline{};
+    bool first_tick = true;
+    std::atomic<bool> stopped{false};
+    std::atomic<std::size_t> ticks{0};
+    std::atomic<std::size_t> missed{0};
+    LatencyHistogram jitter;
+};
+
+// Imprime una línea de resumen: periodo, instantes atendidos y perdidos y jitter en milisegundos
+inline void print_sampling_stats(std::ostream& out, const std::string& name, const SamplingStats& stats) {
+    auto ms = [](std::chrono::nanoseconds value) { return value.count() / 1e6; };
+    out << std::left << std::setw(20) << name << std::right << std::fixed << std::setprecision(2)
+        << " periodo=" << ms(stats.period) << "ms"
+        << " n=" << stats.ticks
+        << " perdidos=" << stats.missed_deadlines
+        << " jitter p50=" << ms(stats.jitter.percentile(0.50)) << "ms"
+        << " p99=" << ms(stats.jitter.percentile(0.99)) << "ms"
+        << " max=" << ms(std::chrono::nanoseconds(stats.jitter.max_ns)) << "ms" << std::endl;
+}
+
+#endif  // PERIODIC_SAMPLER_H
@@ -0,0 +1,332 @@
+#ifndef PIPELINE_H
+#define PIPELINE_H
+
+#include <atomic>
+#include <chrono>
+#include <concepts>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <iomanip>
+#include <iostream>
+#include <memory>
+#include <string>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#include "../comun/clock.h"
+#include "../comun/latency_histogram.h"
+#include "spsc_ring_buffer.h"
+#include "clock_wait.h"
+#include "thread_config.h"
+
+// Capacidad de cada enlace entre etapas: si una etapa se retrasa, la anterior se bloquea al llenarlo
+inline constexpr std::size_t pipeline_link_capacity = 64;
+
+// Enlace entre dos etapas: un único productor (la etapa anterior) y un único consumidor (la siguiente)
+template <typename T>
+using PipelineLink = SpscRingBuffer<T, pipeline_link_capacity>;
+
+// Opciones de una etapa
+struct StageOptions {
+    int cpu = -1;  // Núcleo al que se fija el hilo de la etapa; -1 = donde decida el sistema
+};
+
+// Tiempos y contadores de una etapa (copia en un instante dado)
+struct StageStats {
+    std::string name;
+    int cpu = -1;                   // Núcleo al que se fijó el hilo (-1 si no se fijó)
+    std::size_t processed = 0;      // Elementos recibidos
+    std::size_t emitted = 0;        // Elementos entregados a la etapa siguiente
+    std::size_t input_depth = 0;    // Elementos esperando en la entrada
+    HistogramSnapshot service;      // Trabajo por elemento, sin contar la espera por la etapa siguiente
+    std::chrono::nanoseconds output_wait{0};  // Tiempo total bloqueada porque la etapa siguiente no daba abasto
+};
+
+// Salida de una etapa. La función de la etapa llama a emit() cero, una o varias veces por elemento
+template <typename Out>
+class StageOutput {
+public:
+    StageOutput(PipelineLink<Out>& link, Clock& clock) : link(link), clock(clock) {}
+
+    // Entrega un elemento a la etapa siguiente; espera si su entrada está llena.
+    // Devuelve false si la etapa siguiente ya no acepta datos
+    bool emit(Out item) {
+        if (link.try_push(std::move(item))) {
+            emitted.fetch_add(1, std::memory_order_relaxed);
+            return true;
+        }
+        auto wait_start = clock.now();
+        bool pushed = link.push_wait(std::move(item));
+        auto waited = clock.now() - wait_start;
+        blocked_ns.fetch_add(waited.count(), std::memory_order_relaxed);
+        pending_wait += waited;
+        if (pushed) {
+            emitted.fetch_add(1, std::memory_order_relaxed);  // Solo cuenta lo que de verdad llega a la etapa siguiente
+        }
+        return pushed;
+    }
+
+private:
+    template <typename, typename, typename>
+    friend class TransformStage;
+
+    PipelineLink<Out>& link;
+    Clock& clock;
+    std::atomic<std::size_t> emitted{0};
+    std::atomic<std::int64_t> blocked_ns{0};
+    Clock::duration pending_wait{0};  // Espera de la llamada en curso, se descuenta del tiempo de servicio
+};
+
+// Parte común de todas las etapas: hilo, nombre y medidas
+class StageBase {
+public:
+    StageBase(std::string name, StageOptions options, Clock& clock)
+        : name(std::move(name)), options(options), clock(clock) {}
+    virtual ~StageBase() = default;
+
+    void start() { thread = start_clocked_thread(clock, &StageBase::thread_main, this); }
+
+    void join() {
+        if (thread.joinable()) {
+            join_clocked_thread(clock, thread);
+        }
+    }
+
+    virtual StageStats stats() const = 0;
+
+protected:
+    virtual void run() = 0;
+
+    StageStats base_stats() const {
+        StageStats copy;
+        copy.name = name;
+        copy.cpu = pinned_cpu.load(std::memory_order_relaxed);
+        copy.processed = processed.load(std::memory_order_relaxed);
+        copy.service = service.snapshot();
+        return copy;
+    }
+
+    std::string name;
+    StageOptions options;
+    Clock& clock;
+    std::atomic<int> pinned_cpu{-1};  // Lo escribe el hilo de la etapa; stats() puede leerlo en marcha
+    std::atomic<std::size_t> processed{0};
+    LatencyHistogram service;
+    std::thread thread;
+
+private:
+    // El propio hilo se fija a su núcleo antes de empezar, como los hilos de DataManager: desde fuera, el
+    // hilo ya estaría trabajando donde lo puso el sistema hasta que llegara la configuración
+    void thread_main() {
+        if (options.cpu >= 0) {
+            ThreadConfig config;
+            config.cpus = {options.cpu};
+            if (apply_thread_config(config).affinity_applied) {
+                pinned_cpu.store(options.cpu, std::memory_order_relaxed);
+            }
+        }
+        run();
+    }
+};
+
+// Etapa intermedia: recibe elementos de tipo In y entrega elementos de tipo Out.
+// 'Function' se llama como function(item, output). Si además tiene deadline() y flush(output),
+// la etapa puede retener elementos (por ejemplo, para agruparlos): cuando se alcanza deadline()
+// sin datos nuevos, o al cerrarse la entrada, se llama a flush()
+template <typename In, typename Out, typename Function>
+class TransformStage : public StageBase {
+public:
+    TransformStage(std::string name, PipelineLink<In>& input, PipelineLink<Out>& output_link, Function function,
+                   StageOptions options, Clock& clock)
+        : StageBase(std::move(name), options, clock), input(input), output(output_link, clock),
+          function(std::move(function)) {}
+
+    StageStats stats() const override {
+        StageStats copy = base_stats();
+        copy.emitted = output.emitted.load(std::memory_order_relaxed);
+        copy.input_depth = input.size();
+        copy.output_wait = std::chrono::nanoseconds(output.blocked_ns.load(std::memory_order_relaxed));
+        return copy;
+    }
+
+private:
+    static constexpr bool can_flush = requires(Function& f, StageOutput<Out>& out) {
+        { f.deadline() } -> std::convertible_to<Clock::time_point>;
+        f.flush(out);
+    };
+
+    void run() override {
+        In item;
+        while (true) {
+            Clock::time_point deadline = Clock::time_point::max();
+            if constexpr (can_flush) {
+                deadline = function.deadline();
+            }
+            bool received = deadline == Clock::time_point::max() ? input.pop_wait(item)
+                                                                 : input.pop_wait_until(item, deadline);
+            if (!received) {
+                if (input.closed() && input.empty()) {
+                    break;
+                }
+                if constexpr (can_flush) {
+                    function.flush(output);  // Plazo cumplido sin datos nuevos
+                }
+                continue;
+            }
+            processed.fetch_add(1, std::memory_order_relaxed);
+            timed([&] { function(item, output); });
+        }
+        if constexpr (can_flush) {
+            function.flush(output);  // Lo retenido sale antes de cerrar
+        }
+        output.link.close();  // La etapa siguiente termina cuando vacíe su entrada
+    }
+
+    // Mide el trabajo de la función descontando la espera por la etapa siguiente
+    template <typename Work>
+    void timed(Work work) {
+        output.pending_wait = Clock::duration::zero();
+        auto start = clock.now();
+        work();
+        service.record(clock.now() - start - output.pending_wait);
+    }
+
+    PipelineLink<In>& input;
+    StageOutput<Out> output;
+    Function function;
+};
+
+// Etapa final: consume los elementos sin entregar nada. 'Function' se llama como function(item)
+template <typename In, typename Function>
+class SinkStage : public StageBase {
+public:
+    SinkStage(std::string name, PipelineLink<In>& input, Function function, StageOptions options, Clock& clock)
+        : StageBase(std::move(name), options, clock), input(input), function(std::move(function)) {}
+
+    StageStats stats() const override {
+        StageStats copy = base_stats();
+        copy.input_depth = input.size();
+        return copy;
+    }
+
+private:
+    void run() override {
+        In item;
+        while (input.pop_wait(item)) {
+            processed.fetch_add(1, std::memory_order_relaxed);
+            auto start = clock.now();
+            function(item);
+            service.record(clock.now() - start);
+        }
+    }
+
+    PipelineLink<In>& input;
+    Function function;
+};
+
+// Cadena de etapas, cada una en su propio hilo, unidas por colas SPSC acotadas.
+// Mientras una etapa espera a la radio, las anteriores siguen filtrando y codificando:
+// el trabajo de CPU se solapa con el tiempo de envío en lugar de sumarse a él.
+//
+//     auto& input = pipeline.make_input<Sample>();
+//     auto& frames = pipeline.add_stage<SampleFrame>("agregado", input, FrameAggregator(...));
+//     pipeline.add_sink("transmisión", frames, RadioSink(...));
+//
+// Cada enlace solo puede tener un consumidor: no se debe pasar el mismo enlace a dos etapas.
+// stop() cierra las entradas; cada etapa termina al vaciar la suya y cierra su salida.
+// Es una organización alternativa e independiente: DataManager y SRP_Concurrency_solved no la usan;
+// benchmark_pipeline la compara con hacerlo todo en el hilo de la radio.
+class Pipeline {
+public:
+    explicit Pipeline(Clock& clock = real_time_clock()) : clock(clock), clock_wait(clock) {}
+    Pipeline(const Pipeline&) = delete;
+    Pipeline& operator=(const Pipeline&) = delete;
+
+    ~Pipeline() { stop(); }
+
+    // Crea una entrada de la cadena. Un único hilo externo (por ejemplo, el de un sensor) inserta en ella
+    template <typename T>
+    PipelineLink<T>& make_input() {
+        PipelineLink<T>& link = make_link<T>();
+        inputs.push_back([&link] { link.close(); });
+        return link;
+    }
+
+    // Añade una etapa que lee de 'input' y devuelve el enlace en el que deja sus resultados
+    template <typename Out, typename In, typename Function>
+    PipelineLink<Out>& add_stage(std::string name, PipelineLink<In>& input, Function function,
+                                 StageOptions options = {}) {
+        PipelineLink<Out>& output = make_link<Out>();
+        stages.push_back(std::make_unique<TransformStage<In, Out, Function>>(
+            std::move(name), input, output, std::move(function), options, clock));
+        return output;
+    }
+
+    // Añade la etapa final que consume lo que llega a 'input'
+    template <typename In, typename Function>
+    void add_sink(std::string name, PipelineLink<In>& input, Function function, StageOptions options = {}) {
+        stages.push_back(std::make_unique<SinkStage<In, Function>>(
+            std::move(name), input, std::move(function), options, clock));
+    }
+
+    void start() {
+        for (auto& stage : stages) {
+            stage->start();
+        }
+    }
+
+    // Cierra las entradas y espera a que todas las etapas vacíen sus colas
+    void stop() {
+        for (auto& close_input : inputs) {
+            close_input();
+        }
+        for (auto& stage : stages) {
+            stage->join();
+        }
+    }
+
+    // Medidas de cada etapa, en el orden en que se añadieron; se pueden consultar en marcha
+    std::vector<StageStats> stage_stats() const {
+        std::vector<StageStats> stats;
+        for (const auto& stage : stages) {
+            stats.push_back(stage->stats());
+        }
+        return stats;
+    }
+
+    void print_stage_stats(std::ostream& out) const {
+        auto ms = [](std::chrono::nanoseconds value) { return value.count() / 1e6; };
+        for (const StageStats& stats : stage_stats()) {
+            out << std::left << std::setw(20) << stats.name << std::right << std::fixed << std::setprecision(2)
+                << " n=" << stats.processed
+                << " salida=" << stats.emitted
+                << " servicio media=" << ms(stats.service.mean()) << "ms"
+                << " p99=" << ms(stats.service.percentile(0.99)) << "ms"
+                << " bloqueada=" << ms(stats.output_wait) << "ms";
+            if (stats.cpu >= 0) {
+                out << " cpu=" << stats.cpu;
+            }
+            out << std::endl;
+        }
+    }
+
+private:
+    // Los enlaces se guardan con borrado de tipo; cada uno vive tanto como la cadena
+    template <typename T>
+    PipelineLink<T>& make_link() {
+        auto link = std::make_shared<PipelineLink<T>>();
+        link->use_external_wait(clock_wait.for_queues());
+        links.push_back(link);
+        return *link;
+    }
+
+    Clock& clock;
+    ClockWait clock_wait;  // Las esperas de los enlaces pasan por el reloj si es simulado
+    std::vector<std::shared_ptr<void>> links;
+    std::vector<std::function<void()>> inputs;
+    std::vector<std::unique_ptr<StageBase>> stages;
+};
+
+#endif  // PIPELINE_H
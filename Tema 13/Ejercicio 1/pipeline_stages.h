@@ -0,0 +1,167 @@
+#ifndef PIPELINE_STAGES_H
+#define PIPELINE_STAGES_H
+
+#include <algorithm>
+#include <array>
+#include <chrono>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <type_traits>
+
+#include "../comun/clock.h"
+#include "../comun/latency_histogram.h"
+#include "sample.h"
+#include "simulated_devices.h"
+
+// Grupo de muestras que viajará en una misma trama. Tamaño fijo: pasa por las colas sin reservar memoria
+struct SampleFrame {
+    static constexpr std::size_t max_samples = 8;
+
+    std::array<Sample, max_samples> samples{};
+    std::size_t count = 0;
+};
+
+// Trama ya codificada, lista para la radio
+struct EncodedFrame {
+    static constexpr std::size_t max_bytes = 222;  // Carga útil máxima de una trama LoRaWAN
+
+    std::array<std::uint8_t, max_bytes> bytes{};
+    std::size_t size = 0;
+    std::size_t sample_count = 0;
+    Clock::time_point oldest_capture{};  // Para medir la latencia total al enviarla
+
+    std::span<const std::uint8_t> payload() const { return {bytes.data(), size}; }
+};
+
+static_assert(std::is_trivially_copyable_v<SampleFrame> && std::is_trivially_copyable_v<EncodedFrame>,
+              "Los elementos de la cadena deben poder copiarse sin reservar memoria");
+
+// Etapa de filtrado: descarta lecturas fuera del rango físico del sensor (fallos de lectura)
+class RangeFilter {
+public:
+    RangeFilter(float min_value, float max_value) : min_value(min_value), max_value(max_value) {}
+
+    template <typename Output>
+    void operator()(Sample& sample, Output& output) {
+        if (std::isfinite(sample.value) && sample.value >= min_value && sample.value <= max_value) {
+            output.emit(sample);
+        }
+    }
+
+private:
+    float min_value;
+    float max_value;
+};
+
+// Etapa de agregación: junta muestras en tramas de hasta 'max_samples' sin retener ninguna más de
+// 'max_added_latency'. Una alarma cierra la trama en el acto
+class FrameAggregator {
+public:
+    FrameAggregator(Clock& clock, std::size_t max_samples, Clock::duration max_added_latency)
+        : clock(clock), max_samples(std::clamp<std::size_t>(max_samples, 1, SampleFrame::max_samples)),
+          max_added_latency(max_added_latency) {}
+
+    template <typename Output>
+    void operator()(Sample& sample, Output& output) {
+        if (frame.count == 0) {
+            flush_at = clock.now() + max_added_latency;
+        }
+        frame.samples[frame.count++] = sample;
+        if (frame.count == max_samples || sample.priority == Priority::Alarm || clock.now() >= flush_at) {
+            flush(output);
+        }
+    }
+
+    // Instante en el que hay que enviar la trama aunque no esté llena
+    Clock::time_point deadline() const { return frame.count == 0 ? Clock::time_point::max() : flush_at; }
+
+    template <typename Output>
+    void flush(Output& output) {
+        if (frame.count > 0) {
+            output.emit(frame);
+            frame.count = 0;
+        }
+    }
+
+private:
+    Clock& clock;
+    std::size_t max_samples;
+    Clock::duration max_added_latency;
+    SampleFrame frame;
+    Clock::time_point flush_at{};
+};
+
+// Etapa de codificación: empaqueta la trama en binario compacto.
+// Formato: número de muestras y, por muestra, sensor (16 bits), valor en centésimas (16 bits con signo),
+// prioridad (8 bits) y antigüedad respecto a la primera muestra en ms (16 bits); al final, un CRC-16
+class FrameEncoder {
+public:
+    static constexpr std::size_t bytes_per_sample = 7;
+
+    template <typename Output>
+    void operator()(SampleFrame& frame, Output& output) {
+        EncodedFrame encoded;
+        encoded.sample_count = frame.count;
+        encoded.oldest_capture = frame.samples[0].captured_at;
+        put(encoded, static_cast<std::uint8_t>(frame.count));
+        for (std::size_t i = 0; i < frame.count; ++i) {
+            const Sample& sample = frame.samples[i];
+            encoded.oldest_capture = std::min(encoded.oldest_capture, sample.captured_at);
+            auto centi = static_cast<std::int16_t>(std::clamp(std::lround(sample.value * 100.0f), -32768L, 32767L));
+            auto age_ms = std::chrono::duration_cast<std::chrono::milliseconds>(
+                sample.captured_at - frame.samples[0].captured_at).count();
+            put16(encoded, static_cast<std::uint16_t>(sample.sensor_id));
+            put16(encoded, static_cast<std::uint16_t>(centi));
+            put(encoded, static_cast<std::uint8_t>(sample.priority));
+            put16(encoded, static_cast<std::uint16_t>(std::clamp<long long>(age_ms, 0, 65535)));
+        }
+        put16(encoded, crc16(encoded.payload()));
+        output.emit(encoded);
+    }
+
+    // CRC-16/CCITT-FALSE
+    static std::uint16_t crc16(std::span<const std::uint8_t> data) {
+        std::uint16_t crc = 0xFFFF;
+        for (std::uint8_t byte : data) {
+            crc ^= static_cast<std::uint16_t>(byte << 8);
+            for (int bit = 0; bit < 8; ++bit) {
+                crc = static_cast<std::uint16_t>((crc & 0x8000) ? (crc << 1) ^ 0x1021 : crc << 1);
+            }
+        }
+        return crc;
+    }
+
+private:
+    static void put(EncodedFrame& encoded, std::uint8_t byte) { encoded.bytes[encoded.size++] = byte; }
+
+    static void put16(EncodedFrame& encoded, std::uint16_t value) {
+        put(encoded, static_cast<std::uint8_t>(value & 0xFF));
+        put(encoded, static_cast<std::uint8_t>(value >> 8));
+    }
+
+    static_assert(1 + SampleFrame::max_samples * bytes_per_sample + 2 <= EncodedFrame::max_bytes,
+                  "Una trama llena debe caber en la carga útil");
+};
+
+// Etapa final: envía cada trama codificada por la radio y, si se pide, registra la latencia total
+class RadioSink {
+public:
+    RadioSink(LoRaWANTransmitter& transmitter, Clock& clock, LatencyHistogram* total_latency = nullptr)
+        : transmitter(transmitter), clock(clock), total_latency(total_latency) {}
+
+    void operator()(EncodedFrame& frame) {
+        transmitter.send_encoded(frame.payload(), frame.sample_count);
+        if (total_latency) {
+            total_latency->record(clock.now() - frame.oldest_capture);
+        }
+    }
+
+private:
+    LoRaWANTransmitter& transmitter;
+    Clock& clock;
+    LatencyHistogram* total_latency;
+};
+
+#endif  // PIPELINE_STAGES_H
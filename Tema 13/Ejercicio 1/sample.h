@@ -0,0 +1,41 @@
+#ifndef SAMPLE_H
+#define SAMPLE_H
+
+#include <algorithm>
+#include <array>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <string_view>
+#include <type_traits>
+
+// Prioridad de una muestra: las alarmas adelantan al tráfico ordinario
+enum class Priority : std::uint8_t {
+    Routine,
+    Alarm
+};
+
+// Lectura de un sensor. Es un tipo trivialmente copiable de tamaño fijo: se guarda por valor en los
+// huecos preasignados de las colas y de las tramas, así que moverla nunca reserva memoria
+struct Sample {
+    static constexpr std::size_t max_payload_bytes = 32;
+
+    std::chrono::steady_clock::time_point captured_at;  // Instante de captura
+    std::uint32_t sensor_id = 0;
+    float value = 0.0f;  // Magnitud medida
+    Priority priority = Priority::Routine;
+    std::uint16_t payload_size = 0;
+    std::array<char, max_payload_bytes> payload{};
+
+    // Copia los datos leídos en la carga útil (se truncan si no caben)
+    void set_data(std::string_view data) {
+        payload_size = static_cast<std::uint16_t>(std::min(data.size(), max_payload_bytes));
+        std::copy_n(data.data(), payload_size, payload.data());
+    }
+
+    std::string_view data() const { return std::string_view(payload.data(), payload_size); }
+};
+
+static_assert(std::is_trivially_copyable_v<Sample>, "Sample debe poder copiarse sin reservar memoria");
+
+#endif  // SAMPLE_H
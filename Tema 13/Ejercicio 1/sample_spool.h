@@ -0,0 +1,165 @@
+#ifndef SAMPLE_SPOOL_H
+#define SAMPLE_SPOOL_H
+
+#include <algorithm>
+#include <atomic>
+#include <cerrno>
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <string>
+#include <system_error>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include "sample.h"
+
+// Almacén en disco de muestras pendientes de envío ("store and forward"). Es un registro de solo adición
+// proyectado en memoria con mmap: el lector de un sensor añade muestras al final y un transmisor las
+// consume desde el principio, igual que en una cola SPSC. Los índices viven en la cabecera del fichero,
+// así que lo que no se llegó a enviar sigue ahí tras reiniciar el proceso.
+// Los índices crecen siempre; el hueco físico de una muestra es su índice módulo la capacidad.
+// Protege frente a la caída del proceso (las páginas quedan en la caché del sistema), no frente a un
+// corte de alimentación: no se fuerza la escritura a disco en cada muestra.
+// Los sellos de captura de steady_clock de una ejecución anterior no son comparables con los actuales.
+class SampleSpool {
+public:
+    // Abre el fichero o lo crea si no existe. Si existe con otro formato o capacidad, se vacía.
+    // Lanza std::system_error si no se puede crear o proyectar
+    SampleSpool(const std::string& path, std::size_t capacity) : record_capacity(std::max<std::size_t>(capacity, 1)) {
+        fd = ::open(path.c_str(), O_RDWR | O_CREAT | O_CLOEXEC, 0644);
+        if (fd < 0) {
+            throw std::system_error(errno, std::generic_category(), "No se puede abrir el spool " + path);
+        }
+        mapped_bytes = header_bytes + record_capacity * sizeof(Sample);
+        struct stat info{};
+        bool fresh = ::fstat(fd, &info) != 0 || static_cast<std::size_t>(info.st_size) != mapped_bytes;
+        if (fresh && ::ftruncate(fd, static_cast<off_t>(mapped_bytes)) != 0) {
+            int error = errno;
+            ::close(fd);
+            throw std::system_error(error, std::generic_category(), "No se puede dimensionar el spool " + path);
+        }
+        void* memory = ::mmap(nullptr, mapped_bytes, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+        if (memory == MAP_FAILED) {
+            int error = errno;
+            ::close(fd);
+            throw std::system_error(error, std::generic_category(), "No se puede proyectar el spool " + path);
+        }
+        header = static_cast<Header*>(memory);
+        records = reinterpret_cast<Sample*>(static_cast<char*>(memory) + header_bytes);
+
+        if (fresh || !header_is_valid()) {
+            header->magic = spool_magic;
+            header->record_size = sizeof(Sample);
+            header->capacity = record_capacity;
+            read_index().store(0, std::memory_order_relaxed);
+            write_index().store(0, std::memory_order_relaxed);
+        }
+        recovered = size();
+    }
+
+    SampleSpool(const SampleSpool&) = delete;
+    SampleSpool& operator=(const SampleSpool&) = delete;
+
+    ~SampleSpool() {
+        ::munmap(header, mapped_bytes);
+        ::close(fd);
+    }
+
+    // Añade una muestra al final (solo el productor). Devuelve false si el fichero está lleno
+    bool try_push(const Sample& sample) {
+        const std::uint64_t tail = write_index().load(std::memory_order_relaxed);
+        if (tail - read_index().load(std::memory_order_acquire) == record_capacity) {
+            return false;
+        }
+        records[tail % record_capacity] = sample;
+        write_index().store(tail + 1, std::memory_order_release);
+        return true;
+    }
+
+    // Saca la muestra más antigua (solo el consumidor). Devuelve false si no hay ninguna
+    bool try_pop(Sample& sample) {
+        return pop_bulk(std::span<Sample>(&sample, 1)) == 1;
+    }
+
+    // Saca de una vez hasta out.size() muestras, en orden, con una única actualización del índice de lectura
+    std::size_t pop_bulk(std::span<Sample> out) {
+        std::size_t count = peek_bulk(out);
+        commit(count);
+        return count;
+    }
+
+    // Copia hasta out.size() de las muestras más antiguas sin sacarlas (solo el consumidor): si el proceso
+    // cae antes de commit(), siguen en el fichero y se vuelven a entregar al reiniciar
+    std::size_t peek_bulk(std::span<Sample> out) const {
+        const std::uint64_t head = read_index().load(std::memory_order_relaxed);
+        const std::uint64_t available = write_index().load(std::memory_order_acquire) - head;
+        const std::size_t count = static_cast<std::size_t>(std::min<std::uint64_t>(available, out.size()));
+        for (std::size_t i = 0; i < count; ++i) {
+            out[i] = records[(head + i) % record_capacity];
+        }
+        return count;
+    }
+
+    // Da por entregadas las 'count' muestras más antiguas (solo el consumidor, después de enviarlas)
+    void commit(std::size_t count) {
+        if (count > 0) {
+            read_index().store(read_index().load(std::memory_order_relaxed) + count, std::memory_order_release);
+        }
+    }
+
+    // Número de muestras guardadas (exacto si solo lo consulta uno de los dos hilos)
+    std::size_t size() const {
+        return static_cast<std::size_t>(write_index().load(std::memory_order_acquire) -
+                                        read_index().load(std::memory_order_acquire));
+    }
+
+    bool empty() const { return size() == 0; }
+
+    std::size_t capacity() const { return record_capacity; }
+
+    // Muestras que ya estaban en el fichero al abrirlo (pendientes de una ejecución anterior)
+    std::size_t recovered_count() const { return recovered; }
+
+private:
+    static constexpr std::uint64_t spool_magic = 0x4C4F4F5053303153;  // "S10SPOOL"
+    static constexpr std::size_t header_bytes = 4096;  // Una página: las muestras empiezan alineadas
+
+    // Cabecera del fichero. Los índices van en líneas de caché distintas: uno lo escribe el productor
+    // y el otro el consumidor
+    struct Header {
+        std::uint64_t magic;
+        std::uint64_t record_size;
+        std::uint64_t capacity;
+        alignas(64) std::uint64_t read;
+        alignas(64) std::uint64_t write;
+    };
+    static_assert(sizeof(Header) <= header_bytes);
+    static_assert(std::atomic_ref<std::uint64_t>::is_always_lock_free,
+                  "Los índices se comparten a través del fichero proyectado");
+
+    std::atomic_ref<std::uint64_t> read_index() const { return std::atomic_ref<std::uint64_t>(header->read); }
+    std::atomic_ref<std::uint64_t> write_index() const { return std::atomic_ref<std::uint64_t>(header->write); }
+
+    bool header_is_valid() const {
+        if (header->magic != spool_magic || header->record_size != sizeof(Sample) ||
+            header->capacity != record_capacity) {
+            return false;
+        }
+        std::uint64_t head = header->read;
+        std::uint64_t tail = header->write;
+        return head <= tail && tail - head <= record_capacity;
+    }
+
+    std::size_t record_capacity;
+    int fd = -1;
+    std::size_t mapped_bytes = 0;
+    Header* header = nullptr;
+    Sample* records = nullptr;
+    std::size_t recovered = 0;
+};
+
+#endif  // SAMPLE_SPOOL_H
@@ -0,0 +1,82 @@
+#ifndef SEND_ON_DELTA_H
+#define SEND_ON_DELTA_H
+
+#include <atomic>
+#include <chrono>
+#include <cmath>
+#include <cstddef>
+#include <iomanip>
+#include <iostream>
+#include <string>
+
+#include "../comun/clock.h"
+#include "sample.h"
+
+// Umbrales del envío por cambio ("send on delta") de un sensor
+struct DeltaConfig {
+    float deadband = 0.0f;  // Cambio mínimo respecto al último valor enviado; 0 = se envía todo
+    Clock::duration max_silence{0};  // Pasado este tiempo sin enviar, se envía aunque no cambie; 0 = sin límite
+};
+
+// Contadores del envío por cambio (copia en un instante dado)
+struct SuppressionStats {
+    std::size_t forwarded = 0;   // Lecturas que siguieron hacia la radio
+    std::size_t suppressed = 0;  // Lecturas descartadas por no cambiar lo suficiente
+
+    // Fracción de lecturas que no se enviaron, entre 0 y 1
+    double ratio() const {
+        std::size_t total = forwarded + suppressed;
+        return total == 0 ? 0.0 : static_cast<double>(suppressed) / static_cast<double>(total);
+    }
+};
+
+// Filtro de banda muerta de un sensor: solo deja pasar una lectura si se aleja del último valor enviado
+// al menos 'deadband', si lleva 'max_silence' sin enviar nada o si es una alarma.
+// Lo usa un único hilo (el del sensor); los contadores se pueden leer en vivo desde cualquier otro
+class DeltaFilter {
+public:
+    explicit DeltaFilter(DeltaConfig config = {}) : config(config) {}
+
+    // Decide si la muestra se envía. No cambia la referencia: eso lo hace commit() si la muestra
+    // llega de verdad a la cola
+    bool admit(const Sample& sample) {
+        bool send = config.deadband <= 0.0f || !has_reference || sample.priority == Priority::Alarm ||
+                    std::fabs(sample.value - last_sent_value) >= config.deadband ||
+                    (config.max_silence > Clock::duration::zero() && sample.captured_at - last_sent_at >= config.max_silence);
+        if (!send) {
+            suppressed.fetch_add(1, std::memory_order_relaxed);
+        }
+        return send;
+    }
+
+    // Toma como nueva referencia una muestra admitida que ya va camino de la radio. Si una muestra admitida
+    // se descarta después (por ejemplo, por sobrecarga), no se llama y la referencia sigue siendo la anterior
+    void commit(const Sample& sample) {
+        has_reference = true;
+        last_sent_value = sample.value;
+        last_sent_at = sample.captured_at;
+        forwarded.fetch_add(1, std::memory_order_relaxed);
+    }
+
+    SuppressionStats stats() const {
+        return {forwarded.load(std::memory_order_relaxed), suppressed.load(std::memory_order_relaxed)};
+    }
+
+private:
+    DeltaConfig config;
+    bool has_reference = false;
+    float last_sent_value = 0.0f;
+    Clock::time_point last_sent_at{};
+    std::atomic<std::size_t> forwarded{0};
+    std::atomic<std::size_t> suppressed{0};
+};
+
+// Imprime una línea de resumen: lecturas enviadas, suprimidas y porcentaje suprimido
+inline void print_suppression_stats(std::ostream& out, const std::string& name, const SuppressionStats& stats) {
+    out << std::left << std::setw(20) << name << std::right << std::fixed << std::setprecision(1)
+        << " enviadas=" << stats.forwarded
+        << " suprimidas=" << stats.suppressed
+        << " (" << stats.ratio() * 100.0 << "%)" << std::endl;
+}
+
+#endif  // SEND_ON_DELTA_H
@@ -0,0 +1,100 @@
+#ifndef SIMULATED_DEVICES_H
+#define SIMULATED_DEVICES_H
+
+#include <algorithm>
+#include <iostream>
+#include <atomic>
+#include <string_view>
+#include <vector>
+#include <chrono>
+#include <random>
+#include <span>
+#include <cstdint>
+
+#include "../comun/clock.h"
+#include "sample.h"
+
+// Resultado de una lectura: los datos en crudo y la magnitud medida
+struct SensorReading {
+    std::string_view data;  // Apunta a un buffer del lector válido hasta la siguiente lectura
+    float value;
+};
+
+// Simulador de la lectura de sensores. La magnitud medida sigue un paseo aleatorio desde 'initial_value'
+class SensorReader {
+public:
+    explicit SensorReader(std::chrono::milliseconds read_time = std::chrono::milliseconds(500), bool verbose = true,
+                          float initial_value = 20.0f, Clock& clock = real_time_clock())
+        : read_time(read_time), verbose(verbose), value(initial_value), clock(clock), random(next_seed++) {}
+
+    // Método que simula la recogida de datos de los sensores
+    SensorReading read_sensor_data() {
+        clock.sleep_for(read_time);  // Simula tiempo de lectura
+        value += std::uniform_real_distribution<float>(-0.5f, 0.5f)(random);
+        std::string_view data = "sensor_data";  // Simulación de los datos obtenidos
+        if (verbose) {
+            std::cout << "Datos del sensor leídos: " << data << " (" << value << ")" << std::endl;
+        }
+        return {data, value};
+    }
+
+private:
+    inline static std::atomic<unsigned> next_seed{1};  // Cada lector genera una secuencia distinta
+
+    std::chrono::milliseconds read_time;
+    bool verbose;
+    float value;
+    Clock& clock;
+    std::mt19937 random;
+};
+
+// Simulador de la comunicación LoRaWAN
+class LoRaWANTransmitter {
+public:
+    explicit LoRaWANTransmitter(std::chrono::milliseconds send_time = std::chrono::milliseconds(1000), bool verbose = true,
+                                Clock& clock = real_time_clock())
+        : send_time(send_time), verbose(verbose), clock(clock) {}
+
+    // Método que simula el envío de datos al gateway
+    void send_data(const Sample& sample) {
+        clock.sleep_for(send_time);  // Simula tiempo de envío
+        samples_sent.fetch_add(1, std::memory_order_relaxed);
+        if (verbose) {
+            std::cout << (sample.priority == Priority::Alarm ? "ALARMA enviada al gateway: " : "Datos enviados al gateway: ")
+                      << sample.data() << " (" << sample.value << ")" << std::endl;
+        }
+    }
+
+    // Método que simula el envío de varias muestras en una sola trama: se paga el tiempo de envío una vez
+    void send_frame(const std::vector<Sample>& frame, std::size_t payload_bytes) {
+        clock.sleep_for(send_time);  // Simula tiempo de envío
+        samples_sent.fetch_add(frame.size(), std::memory_order_relaxed);
+        if (verbose) {
+            auto alarms = std::count_if(frame.begin(), frame.end(),
+                                        [](const Sample& sample) { return sample.priority == Priority::Alarm; });
+            std::cout << "Trama enviada al gateway: " << frame.size() << " muestras (" << alarms << " alarmas), "
+                      << payload_bytes << " bytes" << std::endl;
+        }
+    }
+
+    // Método que simula el envío de una trama ya codificada con 'sample_count' muestras
+    void send_encoded(std::span<const std::uint8_t> payload, std::size_t sample_count) {
+        clock.sleep_for(send_time);  // Simula tiempo de envío
+        samples_sent.fetch_add(sample_count, std::memory_order_relaxed);
+        if (verbose) {
+            std::cout << "Trama codificada enviada al gateway: " << sample_count << " muestras, "
+                      << payload.size() << " bytes" << std::endl;
+        }
+    }
+
+    // Número de muestras enviadas hasta ahora
+    std::size_t sent_count() const { return samples_sent.load(std::memory_order_relaxed); }
+
+private:
+    std::chrono::milliseconds send_time;
+    bool verbose;
+    Clock& clock;
+    std::atomic<std::size_t> samples_sent{0};
+};
+
+#endif  // SIMULATED_DEVICES_H
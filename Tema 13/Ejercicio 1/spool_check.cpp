@@ -0,0 +1,91 @@
+// Comprobación: con la radio caída, las muestras que no caben en memoria van al spool en disco
+// y se envían después, aunque entretanto se haya reiniciado DataManager. Al parar no se pierde nada:
+// lo que quedaba en la cola en memoria pasa al spool, y lo leído del spool pero sin enviar sigue en él
+// Compilar: g++ -std=c++20 -O2 -pthread spool_check.cpp -o spool_check
+#include <iostream>
+#include <thread>
+#include <chrono>
+#include <cstdlib>
+#include <filesystem>
+#include <string>
+
+#include "simulated_devices.h"
+#include "data_manager.h"
+
+int main() {
+    const std::string spool_directory = "spool_check";
+    std::filesystem::remove_all(spool_directory);
+
+    DataManagerConfig config;
+    config.overload_policy = OverloadPolicy::SpillToDisk;
+    config.spool_directory = spool_directory;
+    config.print_stats_on_stop = false;
+
+    // Primera ejecución: la radio tarda tanto que prácticamente no envía nada
+    std::size_t backlog = 0;
+    std::size_t first_read = 0;
+    std::size_t first_sent = 0;
+    OverloadStats first_stats;
+    {
+        SensorReader sensor(std::chrono::milliseconds(1), false);
+        LoRaWANTransmitter slow_radio(std::chrono::milliseconds(500), false);
+        DataManager data_manager(sensor, slow_radio, config);
+        data_manager.start();
+        std::this_thread::sleep_for(std::chrono::milliseconds(300));
+        data_manager.stop();
+        first_stats = data_manager.overload_stats();
+        first_read = data_manager.suppression_stats()[0].forwarded;
+        first_sent = slow_radio.sent_count();
+        backlog = data_manager.spool_backlog();
+    }
+    std::cout << "Radio caída: " << first_read << " leídas, " << first_sent << " enviadas, " << first_stats.spooled
+              << " al spool, " << first_stats.dropped << " descartadas, " << backlog << " pendientes al parar"
+              << std::endl;
+
+    // Segunda ejecución: la radio sigue lenta y se para a mitad de un bloque del spool. Lo que no llegó
+    // a enviarse tiene que seguir en el spool
+    std::size_t partial_sent = 0;
+    std::size_t partial_backlog = 0;
+    OverloadStats partial_stats;
+    {
+        SensorReader sensor(std::chrono::milliseconds(1), false);
+        LoRaWANTransmitter slow_radio(std::chrono::milliseconds(50), false);
+        config.sample_period = std::chrono::seconds(10);
+        DataManager data_manager(sensor, slow_radio, config);
+        data_manager.start();
+        std::this_thread::sleep_for(std::chrono::milliseconds(200));
+        data_manager.stop();
+        partial_stats = data_manager.overload_stats();
+        partial_sent = slow_radio.sent_count();
+        partial_backlog = data_manager.spool_backlog();
+    }
+    std::cout << "Parada a mitad de bloque: " << partial_sent << " enviadas, " << partial_backlog << " pendientes"
+              << std::endl;
+
+    // Tercera ejecución: el mismo spool, la radio ya funciona y el sensor apenas produce
+    std::size_t recovered = 0;
+    std::size_t sent = 0;
+    {
+        SensorReader sensor(std::chrono::milliseconds(1), false);
+        LoRaWANTransmitter radio(std::chrono::milliseconds(0), false);
+        config.sample_period = std::chrono::seconds(10);
+        DataManager data_manager(sensor, radio, config);
+        recovered = data_manager.spool_backlog();
+        data_manager.start();
+        for (int i = 0; i < 200 && data_manager.spool_backlog() > 0; ++i) {
+            std::this_thread::sleep_for(std::chrono::milliseconds(10));
+        }
+        data_manager.stop();
+        sent = radio.sent_count();
+        std::cout << "Tras reiniciar: " << recovered << " muestras recuperadas, " << sent << " enviadas, "
+                  << data_manager.spool_backlog() << " pendientes" << std::endl;
+    }
+    std::filesystem::remove_all(spool_directory);
+
+    bool ok = first_stats.spooled > 0 && first_stats.dropped == 0 && backlog > 0 &&
+              first_read == first_sent + backlog &&
+              partial_sent > 0 && partial_backlog == backlog + partial_stats.spooled - partial_sent &&
+              recovered == partial_backlog && sent >= recovered;
+    std::cout << (ok ? "[OK]    " : "[FALLO] ") << "Almacenamiento y reenvío a través de reinicios" << std::endl;
+    return ok ? EXIT_SUCCESS : EXIT_FAILURE;
+}
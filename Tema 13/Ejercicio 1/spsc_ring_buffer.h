@@ -0,0 +1,249 @@
+#ifndef SPSC_RING_BUFFER_H
+#define SPSC_RING_BUFFER_H
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <utility>
+
+// Tamaño de línea de caché usado para separar los índices del productor y del consumidor
+// y evitar el "false sharing" entre ambos hilos
+inline constexpr std::size_t cache_line_size = 64;
+
+// Espera de otro componente en la que puede delegar WaitPoint. La usa, por ejemplo, un reloj simulado,
+// que tiene que ver todas las esperas para saber cuándo puede avanzar el tiempo
+class ExternalWait {
+public:
+    using time_point = std::chrono::steady_clock::time_point;
+
+    virtual ~ExternalWait() = default;
+
+    // Espera hasta que 'ready' devuelva true o se alcance 'deadline'. Devuelve el último valor de 'ready'
+    virtual bool wait_until(time_point deadline, const std::function<bool()>& ready) = 0;
+
+    virtual void notify_waiters() = 0;
+};
+
+// Punto de espera bloqueante. El camino rápido es un único contador atómico:
+// si nadie está esperando, notify() no toma ningún mutex ni hace llamadas al sistema.
+// Solo los hilos que de verdad tienen que dormir usan el mutex y la variable de condición.
+// Con una espera externa, todas las esperas y avisos pasan por ella.
+class WaitPoint {
+public:
+    using time_point = ExternalWait::time_point;
+
+    // nullptr vuelve a la espera propia. La espera externa tiene que vivir más que el WaitPoint
+    void use_external_wait(ExternalWait* wait) { external_wait = wait; }
+
+    // Bloquea el hilo mientras 'must_wait' devuelva true
+    template <typename Predicate>
+    void wait_while(Predicate must_wait) {
+        if (external_wait) {
+            external_wait->wait_until(time_point::max(), [&] { return !must_wait(); });
+            return;
+        }
+        if (!spin_while(must_wait)) {
+            return;
+        }
+        std::unique_lock<std::mutex> lock(mtx);
+        waiters.fetch_add(1);  // Anunciarse antes de volver a comprobar para no perder notificaciones
+        cv.wait(lock, [&] { return !must_wait(); });
+        waiters.fetch_sub(1);
+    }
+
+    // Igual que wait_while pero con plazo. Devuelve false si se alcanza 'deadline' y aún hay que esperar
+    template <typename Predicate>
+    bool wait_while_until(time_point deadline, Predicate must_wait) {
+        if (external_wait) {
+            return external_wait->wait_until(deadline, [&] { return !must_wait(); });
+        }
+        if (!spin_while(must_wait)) {
+            return true;
+        }
+        std::unique_lock<std::mutex> lock(mtx);
+        waiters.fetch_add(1);
+        bool ready = cv.wait_until(lock, deadline, [&] { return !must_wait(); });
+        waiters.fetch_sub(1);
+        return ready;
+    }
+
+    // Despierta a los hilos bloqueados, si los hay
+    void notify() {
+        if (external_wait) {
+            external_wait->notify_waiters();
+        } else if (waiters.load() > 0) {
+            { std::lock_guard<std::mutex> lock(mtx); }  // Sincroniza con el hilo que se está durmiendo
+            cv.notify_all();
+        }
+    }
+
+private:
+    static constexpr int yields_before_sleep = 16;
+
+    // Antes de dormir cede la CPU unas pocas veces: suele bastar para que el otro hilo avance.
+    // Devuelve true si después de ceder todavía hay que esperar
+    template <typename Predicate>
+    static bool spin_while(Predicate& must_wait) {
+        for (int i = 0; i < yields_before_sleep; ++i) {
+            if (!must_wait()) {
+                return false;
+            }
+            std::this_thread::yield();
+        }
+        return must_wait();
+    }
+
+    ExternalWait* external_wait = nullptr;
+    std::atomic<int> waiters{0};
+    std::mutex mtx;
+    std::condition_variable cv;
+};
+
+// Cola circular de capacidad fija para un único productor y un único consumidor (SPSC).
+// No usa mutex: cada índice solo lo escribe un hilo y los datos se publican con acquire/release.
+template <typename T, std::size_t Capacity>
+class SpscRingBuffer {
+    static_assert(Capacity >= 2 && (Capacity & (Capacity - 1)) == 0,
+                  "La capacidad debe ser una potencia de dos");
+
+public:
+    // Inserta un elemento sin bloquear. Devuelve false si la cola está llena
+    // (en ese caso el elemento no se mueve y el llamante lo conserva)
+    bool try_push(T&& item) { return push_slot(std::move(item)); }
+    bool try_push(const T& item) { return push_slot(item); }
+
+    // Extrae un elemento sin bloquear. Devuelve false si la cola está vacía
+    bool try_pop(T& item) {
+        const std::size_t head = head_index.load(std::memory_order_relaxed);
+        if (head == cached_tail) {
+            cached_tail = tail_index.load(std::memory_order_acquire);
+            if (head == cached_tail) {
+                return false;
+            }
+        }
+        item = std::move(slots[head & mask]);
+        head_index.store(head + 1, std::memory_order_seq_cst);  // seq_cst: empareja con WaitPoint
+        space_available.notify();
+        return true;
+    }
+
+    // Inserta un elemento esperando (sin consumir CPU) a que haya hueco.
+    // Devuelve false si la cola se ha cerrado antes de poder insertarlo
+    bool push_wait(T item) {
+        while (!try_push(std::move(item))) {
+            if (closed()) {
+                return false;
+            }
+            space_available.wait_while([this] { return full() && !closed(); });
+        }
+        return true;
+    }
+
+    // Extrae un elemento esperando (sin consumir CPU) a que haya datos.
+    // Devuelve false si la cola está cerrada y vacía
+    bool pop_wait(T& item) {
+        bool popped = false;
+        while (!pop_or_closed(item, popped)) {
+            data_available.wait_while([this] { return empty() && !closed(); });
+        }
+        return popped;
+    }
+
+    // Igual que pop_wait pero con plazo. Devuelve false si se alcanza 'deadline' sin datos
+    // o si la cola está cerrada y vacía
+    bool pop_wait_until(T& item, WaitPoint::time_point deadline) {
+        bool popped = false;
+        while (!pop_or_closed(item, popped)) {
+            if (!data_available.wait_while_until(deadline, [this] { return empty() && !closed(); })) {
+                return false;
+            }
+        }
+        return popped;
+    }
+
+    // Hace que las esperas bloqueantes de la cola pasen por 'wait' (ver WaitPoint::use_external_wait)
+    void use_external_wait(ExternalWait* wait) {
+        data_available.use_external_wait(wait);
+        space_available.use_external_wait(wait);
+    }
+
+    // Cierra la cola y despierta a los hilos que estén esperando en ella
+    void close() {
+        closed_flag.store(true);
+        data_available.notify();
+        space_available.notify();
+    }
+
+    bool closed() const { return closed_flag.load(); }
+
+    bool empty() const { return size() == 0; }
+
+    bool full() const { return size() == Capacity; }
+
+    // Número aproximado de elementos (exacto si solo lo consulta uno de los dos hilos).
+    // Se lee primero 'head': la cola leída después nunca queda por detrás, así que la resta no da la vuelta.
+    // Entre las dos lecturas el productor puede seguir metiendo y el consumidor sacando, de ahí el tope
+    std::size_t size() const {
+        std::size_t head = head_index.load();
+        std::size_t tail = tail_index.load();
+        return std::min(tail - head, Capacity);
+    }
+
+    static constexpr std::size_t capacity() { return Capacity; }
+
+private:
+    static constexpr std::size_t mask = Capacity - 1;
+
+    // Intento de extracción de las esperas bloqueantes. Devuelve true si ya no hay que esperar más: hay
+    // elemento ('popped' a true) o la cola está cerrada y vacía. El orden importa: el productor puede insertar
+    // y cerrar entre el primer try_pop y la consulta de closed(), así que tras ver la cola cerrada hay que
+    // volver a intentarlo; si no, se perdería el último elemento
+    bool pop_or_closed(T& item, bool& popped) {
+        popped = try_pop(item);
+        if (popped) {
+            return true;
+        }
+        if (!closed()) {
+            return false;
+        }
+        popped = try_pop(item);
+        return true;
+    }
+
+    template <typename U>
+    bool push_slot(U&& item) {
+        const std::size_t tail = tail_index.load(std::memory_order_relaxed);
+        if (tail - cached_head == Capacity) {
+            cached_head = head_index.load(std::memory_order_acquire);
+            if (tail - cached_head == Capacity) {
+                return false;
+            }
+        }
+        slots[tail & mask] = std::forward<U>(item);
+        tail_index.store(tail + 1, std::memory_order_seq_cst);  // seq_cst: empareja con WaitPoint
+        data_available.notify();
+        return true;
+    }
+
+    // Índice de lectura: solo lo escribe el consumidor
+    alignas(cache_line_size) std::atomic<std::size_t> head_index{0};
+    std::size_t cached_tail = 0;  // Copia local del índice del productor (la usa el consumidor)
+
+    // Índice de escritura: solo lo escribe el productor
+    alignas(cache_line_size) std::atomic<std::size_t> tail_index{0};
+    std::size_t cached_head = 0;  // Copia local del índice del consumidor (la usa el productor)
+
+    alignas(cache_line_size) WaitPoint data_available;
+    alignas(cache_line_size) WaitPoint space_available;
+    std::atomic<bool> closed_flag{false};
+
+    alignas(cache_line_size) std::array<T, Capacity> slots{};
+};
+
+#endif  // SPSC_RING_BUFFER_H
@@ -0,0 +1,94 @@
+#ifndef THREAD_CONFIG_H
+#define THREAD_CONFIG_H
+
+#include <thread>
+#include <vector>
+
+#ifdef __linux__
+#include <pthread.h>
+#include <sched.h>
+#include <sys/mman.h>
+#endif
+
+// Política de planificación de un hilo
+enum class SchedulingPolicy {
+    Other,  // SCHED_OTHER: reparto normal del sistema
+    Fifo    // SCHED_FIFO: tiempo real, solo lo expulsa un hilo de mayor prioridad (requiere privilegios)
+};
+
+// Colocación y planificación de un hilo
+struct ThreadConfig {
+    std::vector<int> cpus;  // Núcleos en los que puede ejecutarse; vacío = en cualquiera
+    SchedulingPolicy policy = SchedulingPolicy::Other;
+    int priority = 0;  // Prioridad de SCHED_FIFO (1 a 99); con SCHED_OTHER se ignora
+
+    bool is_default() const { return cpus.empty() && policy == SchedulingPolicy::Other; }
+};
+
+// Qué partes de la configuración se pudieron aplicar
+struct ThreadConfigResult {
+    bool affinity_applied = true;
+    bool scheduling_applied = true;
+
+    bool ok() const { return affinity_applied && scheduling_applied; }
+};
+
+#ifdef __linux__
+// Aplica la configuración a un hilo ya creado. Lo que el sistema no permita (por ejemplo, SCHED_FIFO
+// sin privilegios) se queda como estaba y se indica en el resultado
+inline ThreadConfigResult apply_thread_config(pthread_t thread, const ThreadConfig& config) {
+    ThreadConfigResult result;
+    if (!config.cpus.empty()) {
+        cpu_set_t cpus;
+        CPU_ZERO(&cpus);
+        for (int cpu : config.cpus) {
+            CPU_SET(cpu, &cpus);
+        }
+        result.affinity_applied = pthread_setaffinity_np(thread, sizeof(cpus), &cpus) == 0;
+    }
+    sched_param parameters{};
+    int policy = SCHED_OTHER;
+    if (config.policy == SchedulingPolicy::Fifo) {
+        policy = SCHED_FIFO;
+        parameters.sched_priority = config.priority;
+    }
+    result.scheduling_applied = pthread_setschedparam(thread, policy, &parameters) == 0;
+    return result;
+}
+
+// Aplica la configuración al hilo que llama: así rige desde la primera instrucción de su trabajo
+inline ThreadConfigResult apply_thread_config(const ThreadConfig& config) {
+    return apply_thread_config(pthread_self(), config);
+}
+
+inline ThreadConfigResult apply_thread_config(std::thread& thread, const ThreadConfig& config) {
+    return apply_thread_config(thread.native_handle(), config);
+}
+
+// Bloquea en RAM la memoria actual y futura del proceso: ningún fallo de página ni paginación a disco
+// retrasa a los hilos de tiempo real. Devuelve false si no hay permisos o el límite es insuficiente
+inline bool lock_process_memory() { return mlockall(MCL_CURRENT | MCL_FUTURE) == 0; }
+
+inline void unlock_process_memory() { munlockall(); }
+#else
+inline ThreadConfigResult apply_thread_config(const ThreadConfig& config) {
+    return {config.cpus.empty(), config.policy == SchedulingPolicy::Other};
+}
+
+inline ThreadConfigResult apply_thread_config(std::thread&, const ThreadConfig& config) {
+    return apply_thread_config(config);
+}
+
+inline bool lock_process_memory() { return false; }
+
+inline void unlock_process_memory() {}
+#endif
+
+// Fija un hilo a un núcleo. Devuelve false si el sistema no lo permite
+inline bool pin_thread_to_core(std::thread& thread, int cpu) {
+    ThreadConfig config;
+    config.cpus = {cpu};
+    return apply_thread_config(thread, config).affinity_applied;
+}
+
+#endif  // THREAD_CONFIG_H
@@ -1,58 +1,47 @@
 #include <iostream>
 #include <thread>
-#include <mutex>
 #include <chrono>
 
-class SharedData {
-public:
-    // Constructor
-    SharedData() : value(0) {}
+#include "../comun/clock.h"
+#include "shared_data.h"
 
-    // Función para incrementar el valor
-    void increment() {
-        std::lock_guard<std::mutex> lock(mtx); // Asegura la exclusión mutua
-        ++value;
-        std::cout << "Valor incrementado a: " << value << std::endl;
-    }
-
-    // Función para obtener el valor actual
-    int get_value() {
-        std::lock_guard<std::mutex> lock(mtx); // Asegura la exclusión mutua
-        return value;
-    }
-
-private:
-    int value;                // Dato compartido
-    std::mutex mtx;          // Mutex para proteger el acceso a 'value'
-};
+const int increment_count = 5;
 
 // Función que representa un hilo que incrementa el valor
-void increment_data(SharedData& data) {
-    for (int i = 0; i < 5; ++i) {
-        data.increment();
-        std::this_thread::sleep_for(std::chrono::milliseconds(100)); // Simula trabajo
+void increment_data(SharedData<int>& data, Clock& clock) {
+    for (int i = 0; i < increment_count; ++i) {
+        int value = data.increment();
+        std::cout << "Valor incrementado a: " << value << std::endl;  // Fuera de la operación compartida
+        clock.sleep_for(std::chrono::milliseconds(100)); // Simula trabajo
     }
 }
 
-// Función que representa un hilo que lee el valor
-void read_data(SharedData& data) {
-    for (int i = 0; i < 5; ++i) {
-        int value = data.get_value();
+// Función que representa un hilo que lee el valor cada vez que cambia, sin consultarlo periódicamente
+void read_data(SharedData<int>& data) {
+    int last_seen = 0;  // Valor inicial de SharedData<int>
+    while (last_seen < increment_count) {
+        int value = data.wait_for_change(last_seen, std::chrono::seconds(1));
+        if (value == last_seen) {
+            std::cout << "Sin cambios en 1 s" << std::endl;
+            break;
+        }
         std::cout << "Valor leído: " << value << std::endl;
-        std::this_thread::sleep_for(std::chrono::milliseconds(150)); // Simula trabajo
+        last_seen = value;
     }
 }
 
 int main() {
-    SharedData shared_data;
+    SharedData<int> shared_data;
+    Clock& clock = real_time_clock();  // Con un SimulatedClock las esperas no consumen tiempo real
 
     // Crear hilos para incrementar y leer el valor
-    std::thread increment_thread(increment_data, std::ref(shared_data));
+    std::thread increment_thread = start_clocked_thread(clock, increment_data, std::ref(shared_data), std::ref(clock));
+    // El lector no participa en el reloj: no espera plazos, sino cambios del dato
     std::thread read_thread(read_data, std::ref(shared_data));
 
     // Esperar a que ambos hilos terminen
-    increment_thread.join();
-    read_thread.join();
+    join_clocked_thread(clock, increment_thread);
+    join_clocked_thread(clock, read_thread);
 
     std::cout << "Proceso finalizado." << std::endl;
     return 0;
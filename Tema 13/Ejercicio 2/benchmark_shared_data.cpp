@@ -0,0 +1,78 @@
+// Benchmark: incrementos concurrentes de SharedData con mutex, atómico y repartido en porciones, de 1 a 64 hilos
+// Compilar: g++ -std=c++20 -O2 -pthread benchmark_shared_data.cpp -o benchmark_shared_data
+#include <iostream>
+#include <iomanip>
+#include <chrono>
+#include <thread>
+#include <vector>
+#include <atomic>
+#include <string>
+
+#include "shared_data.h"
+
+using BenchmarkClock = std::chrono::steady_clock;
+
+// Lanza 'thread_count' hilos que incrementan a la vez; devuelve millones de incrementos por segundo.
+// Todos esperan a una señal común para que la contención empiece a la vez
+template <typename Data>
+double run_benchmark(unsigned thread_count, int increments_per_thread) {
+    Data data;
+    std::atomic<bool> go{false};
+    std::vector<std::thread> threads;
+    for (unsigned i = 0; i < thread_count; ++i) {
+        threads.emplace_back([&] {
+            while (!go.load(std::memory_order_acquire)) {
+                std::this_thread::yield();
+            }
+            for (int j = 0; j < increments_per_thread; ++j) {
+                data.increment();
+            }
+        });
+    }
+    auto start = BenchmarkClock::now();
+    go.store(true, std::memory_order_release);
+    for (auto& thread : threads) {
+        thread.join();
+    }
+    std::chrono::duration<double> elapsed = BenchmarkClock::now() - start;
+
+    long long expected = static_cast<long long>(thread_count) * increments_per_thread;
+    if (data.get_value() != expected) {
+        std::cerr << "Se han perdido incrementos: " << data.get_value() << " de " << expected << std::endl;
+    }
+    return expected / elapsed.count() / 1e6;
+}
+
+int main() {
+    const int increments_per_thread = 200'000;
+
+    std::cout << std::thread::hardware_concurrency() << " núcleo(s), " << increments_per_thread
+              << " incrementos por hilo\n";
+    std::cout << std::setw(8) << "hilos" << std::setw(16) << "mutex (M/s)" << std::setw(16) << "atómico (M/s)"
+              << std::setw(18) << "porciones (M/s)" << "\n";
+    for (unsigned threads : {1u, 2u, 4u, 8u, 16u, 32u, 64u}) {
+        double with_mutex = run_benchmark<MutexSharedData>(threads, increments_per_thread);
+        double with_atomic = run_benchmark<SharedData<int>>(threads, increments_per_thread);
+        double with_shards = run_benchmark<ShardedSharedData>(threads, increments_per_thread);
+        std::cout << std::setw(8) << threads << std::fixed << std::setprecision(2)
+                  << std::setw(16) << with_mutex << std::setw(16) << with_atomic
+                  << std::setw(18) << with_shards << "\n";
+    }
+
+    // La lectura aproximada se queda por detrás como mucho fold_interval - 1 incrementos por porción
+    ShardedSharedData sharded;
+    std::vector<std::thread> threads;
+    for (int i = 0; i < 8; ++i) {
+        threads.emplace_back([&sharded, i] {
+            for (int j = 0; j < 100'000 + i * 37; ++j) {
+                sharded.increment();
+            }
+        });
+    }
+    for (auto& thread : threads) {
+        thread.join();
+    }
+    std::cout << "Porciones: " << sharded.shard_count() << ", valor exacto: " << sharded.get_value()
+              << ", aproximado: " << sharded.get_approximate_value() << "\n";
+    return 0;
+}
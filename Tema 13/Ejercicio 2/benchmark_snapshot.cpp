@@ -0,0 +1,139 @@
+// Benchmark: lectores de un estado de varios campos con seqlock (SharedData<T>), std::shared_mutex y std::mutex
+// Compilar: g++ -std=c++20 -O2 -pthread benchmark_snapshot.cpp -o benchmark_snapshot
+#include <iostream>
+#include <iomanip>
+#include <chrono>
+#include <thread>
+#include <vector>
+#include <atomic>
+#include <mutex>
+#include <shared_mutex>
+#include <cstdint>
+
+#include "shared_data.h"
+
+using BenchmarkClock = std::chrono::steady_clock;
+
+// Estado compartido de varios campos. Todos se derivan de 'sequence': una copia incoherente se detecta
+struct SensorState {
+    std::uint64_t sequence = 0;
+    double temperature = 0.0;
+    double humidity = 0.0;
+    double pressure = 0.0;
+    std::int64_t timestamp_ns = 0;
+
+    static SensorState make(std::uint64_t sequence) {
+        auto value = static_cast<double>(sequence);
+        return {sequence, value, value * 2.0, value * 3.0, static_cast<std::int64_t>(sequence) * 1000};
+    }
+
+    bool consistent() const { return *this == make(sequence); }
+    bool operator==(const SensorState&) const = default;
+};
+
+// Equivalente con std::shared_mutex: los lectores comparten el cerrojo, pero cada lectura escribe en él
+class SharedMutexData {
+public:
+    void store(const SensorState& value) {
+        std::unique_lock<std::shared_mutex> lock(mtx);
+        state = value;
+    }
+
+    SensorState load() const {
+        std::shared_lock<std::shared_mutex> lock(mtx);
+        return state;
+    }
+
+private:
+    mutable std::shared_mutex mtx;
+    SensorState state;
+};
+
+// Equivalente con std::mutex: lectores y escritor se excluyen entre sí
+class MutexData {
+public:
+    void store(const SensorState& value) {
+        std::lock_guard<std::mutex> lock(mtx);
+        state = value;
+    }
+
+    SensorState load() const {
+        std::lock_guard<std::mutex> lock(mtx);
+        return state;
+    }
+
+private:
+    mutable std::mutex mtx;
+    SensorState state;
+};
+
+struct BenchmarkResult {
+    double reads_per_second;
+    std::size_t torn_reads;  // Copias incoherentes (deben ser 0)
+};
+
+// Un escritor actualiza el estado cada ~20 us mientras 'reader_count' hilos lo leen sin pausa
+template <typename Data>
+BenchmarkResult run_benchmark(unsigned reader_count, std::chrono::milliseconds length) {
+    Data data;
+    std::atomic<bool> stop{false};
+    std::atomic<std::uint64_t> reads{0};
+    std::atomic<std::size_t> torn{0};
+    std::uint64_t writes = 0;
+
+    std::vector<std::thread> readers;
+    for (unsigned i = 0; i < reader_count; ++i) {
+        readers.emplace_back([&] {
+            std::uint64_t local_reads = 0;
+            std::size_t local_torn = 0;
+            while (!stop.load(std::memory_order_relaxed)) {
+                SensorState state = data.load();
+                local_torn += state.consistent() ? 0 : 1;
+                ++local_reads;
+            }
+            reads += local_reads;
+            torn += local_torn;
+        });
+    }
+    std::thread writer([&] {
+        while (!stop.load(std::memory_order_relaxed)) {
+            data.store(SensorState::make(++writes));
+            auto next = BenchmarkClock::now() + std::chrono::microseconds(20);
+            while (BenchmarkClock::now() < next) {
+                std::this_thread::yield();
+            }
+        }
+    });
+
+    auto start = BenchmarkClock::now();
+    std::this_thread::sleep_for(length);
+    stop = true;
+    writer.join();
+    for (auto& reader : readers) {
+        reader.join();
+    }
+    std::chrono::duration<double> elapsed = BenchmarkClock::now() - start;
+    return {reads / elapsed.count(), torn.load()};
+}
+
+int main() {
+    const std::chrono::milliseconds length(300);
+
+    std::cout << std::thread::hardware_concurrency() << " núcleo(s), estado de " << sizeof(SensorState)
+              << " bytes, un escritor\n";
+    std::cout << std::setw(9) << "lectores" << std::setw(18) << "seqlock (M/s)" << std::setw(20) << "shared_mutex (M/s)"
+              << std::setw(14) << "mutex (M/s)" << "\n";
+    std::size_t torn_reads = 0;
+    for (unsigned readers : {1u, 2u, 4u, 8u, 16u}) {
+        BenchmarkResult seqlock = run_benchmark<SharedData<SensorState>>(readers, length);
+        BenchmarkResult shared_mutex = run_benchmark<SharedMutexData>(readers, length);
+        BenchmarkResult mutex = run_benchmark<MutexData>(readers, length);
+        torn_reads += seqlock.torn_reads + shared_mutex.torn_reads + mutex.torn_reads;
+        std::cout << std::setw(9) << readers << std::fixed << std::setprecision(2)
+                  << std::setw(18) << seqlock.reads_per_second / 1e6
+                  << std::setw(20) << shared_mutex.reads_per_second / 1e6
+                  << std::setw(14) << mutex.reads_per_second / 1e6 << "\n";
+    }
+    std::cout << "Copias incoherentes: " << torn_reads << std::endl;
+    return torn_reads == 0 ? 0 : 1;
+}
@@ -0,0 +1,297 @@
+#ifndef SHARED_DATA_H
+#define SHARED_DATA_H
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <bit>
+#include <chrono>
+#include <climits>
+#include <concepts>
+#include <ctime>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <type_traits>
+
+#ifdef __linux__
+#include <linux/futex.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+// Dato compartido de cualquier tipo trivialmente copiable (por ejemplo, una estructura con varios campos),
+// protegido con un "seqlock". El escritor incrementa un número de secuencia antes y después de escribir
+// (impar = escritura en curso); el lector copia los datos y, si la secuencia cambió mientras copiaba,
+// repite la copia. Los lectores no toman ningún cerrojo ni escriben en memoria compartida: nunca
+// bloquean al escritor ni se estorban entre sí, y siempre obtienen una copia coherente.
+// Conviene cuando se lee mucho más de lo que se escribe y el dato es pequeño (unas pocas líneas de caché).
+// Los datos se guardan en palabras atómicas copiadas con orden relaxed: así la copia concurrente con
+// una escritura no es una carrera de datos, y las barreras alrededor de la secuencia dan el orden
+template <typename T>
+class SharedData {
+    static_assert(std::is_trivially_copyable_v<T>, "SharedData<T> copia T byte a byte");
+    static_assert(std::is_default_constructible_v<T>, "SharedData<T> necesita construir la copia que devuelve");
+
+public:
+    SharedData() : SharedData(T{}) {}
+    explicit SharedData(const T& initial) { store(initial); }
+
+    // Sustituye el valor. Varios escritores se turnan; los lectores nunca les hacen esperar
+    void store(const T& value) {
+        std::uint64_t sequence = begin_write();
+        write_words(value);
+        end_write(sequence);
+    }
+
+    // Lee, modifica y escribe el valor sin que otro escritor se cuele entre medias
+    template <typename Function>
+    void update(Function function) {
+        std::uint64_t sequence = begin_write();
+        T value = read_words();
+        function(value);
+        write_words(value);
+        end_write(sequence);
+    }
+
+    // Copia coherente del valor: nunca mezcla campos de dos escrituras distintas
+    T load() const {
+        while (true) {
+            std::uint64_t before = sequence_number.load(std::memory_order_acquire);
+            if (before & 1) {
+                std::this_thread::yield();  // Escritura en curso
+                continue;
+            }
+            T value = read_words();
+            std::atomic_thread_fence(std::memory_order_acquire);  // La copia no se adelanta a la segunda lectura
+            if (sequence_number.load(std::memory_order_relaxed) == before) {
+                return value;
+            }
+        }
+    }
+
+private:
+    static constexpr std::size_t word_count = (sizeof(T) + sizeof(std::uint64_t) - 1) / sizeof(std::uint64_t);
+
+    // Toma el turno de escritura pasando la secuencia de par a impar
+    std::uint64_t begin_write() {
+        std::uint64_t sequence = sequence_number.load(std::memory_order_relaxed);
+        while ((sequence & 1) ||
+               !sequence_number.compare_exchange_weak(sequence, sequence + 1, std::memory_order_acquire)) {
+            std::this_thread::yield();
+            sequence = sequence_number.load(std::memory_order_relaxed);
+        }
+        std::atomic_thread_fence(std::memory_order_release);  // La secuencia impar se ve antes que los datos nuevos
+        return sequence;
+    }
+
+    void end_write(std::uint64_t sequence) {
+        sequence_number.store(sequence + 2, std::memory_order_release);  // Publica los datos
+    }
+
+    void write_words(const T& value) {
+        std::array<std::uint64_t, word_count> buffer{};
+        std::memcpy(buffer.data(), &value, sizeof(T));
+        for (std::size_t i = 0; i < word_count; ++i) {
+            words[i].store(buffer[i], std::memory_order_relaxed);
+        }
+    }
+
+    T read_words() const {
+        std::array<std::uint64_t, word_count> buffer;
+        for (std::size_t i = 0; i < word_count; ++i) {
+            buffer[i] = words[i].load(std::memory_order_relaxed);
+        }
+        T value;
+        std::memcpy(static_cast<void*>(&value), buffer.data(), sizeof(T));
+        return value;
+    }
+
+    std::atomic<std::uint64_t> sequence_number{0};
+    std::array<std::atomic<std::uint64_t>, word_count> words{};
+};
+
+// Especialización para un contador entero: el incremento es una única instrucción atómica (fetch_add).
+// El contador no publica ningún otro dato, así que para el valor bastaría memory_order_relaxed; el
+// incremento es seq_cst solo para emparejarse con el contador de hilos en espera de wait_for_change
+// (en x86 la instrucción es la misma). Si nadie espera, avisar del cambio es leer ese contador
+template <std::integral T>
+class SharedData<T> {
+public:
+    // Constructor
+    SharedData() : value(0) {}
+
+    // Función para incrementar el valor. Devuelve el valor resultante para que quien llama
+    // lo muestre fuera de la operación compartida
+    T increment() {
+        T result = value.fetch_add(1, std::memory_order_seq_cst) + 1;
+        notify_change();
+        return result;
+    }
+
+    // Función para obtener el valor actual
+    T get_value() const {
+        return value.load(std::memory_order_relaxed);
+    }
+
+    void store(T new_value) {
+        value.store(new_value, std::memory_order_seq_cst);
+        notify_change();
+    }
+
+    T load() const { return get_value(); }
+
+    // Espera sin consumir CPU hasta que el valor sea distinto de 'last_seen' o pase 'timeout'.
+    // Devuelve el valor actual: si coincide con 'last_seen', se agotó el plazo sin cambios.
+    // En Linux duerme en un futex sobre 'changes', una palabra de 32 bits aparte, así que vale para enteros
+    // de cualquier tamaño (std::atomic::wait haría lo mismo, pero no admite plazo). En otros sistemas
+    // comprueba el valor cada milisegundo
+    template <typename Rep, typename Period>
+    T wait_for_change(T last_seen, std::chrono::duration<Rep, Period> timeout) const {
+        T current = value.load(std::memory_order_acquire);
+        if (current != last_seen) {
+            return current;
+        }
+        auto deadline = std::chrono::steady_clock::now() + timeout;
+        waiters.fetch_add(1, std::memory_order_seq_cst);  // Antes de volver a leer: empareja con notify_change
+        while (true) {
+            // 'changes' se lee antes que el valor: si el valor cambia después, notify_change ya ve a este
+            // hilo esperando y cambia 'changes', y el futex no llega a dormir
+            std::uint32_t seen_changes = changes.load(std::memory_order_seq_cst);
+            if ((current = value.load(std::memory_order_seq_cst)) != last_seen) {
+                break;
+            }
+            auto remaining = deadline - std::chrono::steady_clock::now();
+            if (remaining <= std::chrono::steady_clock::duration::zero()) {
+                break;
+            }
+            sleep_while_unchanged(seen_changes, remaining);
+        }
+        waiters.fetch_sub(1, std::memory_order_relaxed);
+        return current;
+    }
+
+private:
+    // Despierta a los que esperan un cambio; sin esperas pendientes no toca 'changes' ni hace llamadas al sistema
+    void notify_change() {
+        if (waiters.load(std::memory_order_seq_cst) == 0) {
+            return;
+        }
+        changes.fetch_add(1, std::memory_order_seq_cst);
+#ifdef __linux__
+        ::syscall(SYS_futex, changes_word(), FUTEX_WAKE_PRIVATE, INT_MAX, nullptr, nullptr, 0);
+#endif
+    }
+
+    // Duerme mientras 'changes' siga valiendo 'seen_changes', como mucho 'remaining'. Puede volver antes de tiempo
+    void sleep_while_unchanged(std::uint32_t seen_changes, std::chrono::steady_clock::duration remaining) const {
+#ifdef __linux__
+        auto nanoseconds = std::chrono::duration_cast<std::chrono::nanoseconds>(remaining).count();
+        timespec relative{};
+        relative.tv_sec = static_cast<std::time_t>(nanoseconds / 1'000'000'000);
+        relative.tv_nsec = static_cast<long>(nanoseconds % 1'000'000'000);
+        // El núcleo solo duerme si 'changes' sigue valiendo 'seen_changes': un aviso entre la última lectura
+        // y esta llamada no se pierde
+        ::syscall(SYS_futex, changes_word(), FUTEX_WAIT_PRIVATE, seen_changes, &relative, nullptr, 0);
+#else
+        (void)seen_changes;
+        std::this_thread::sleep_for(std::min<std::chrono::steady_clock::duration>(remaining, std::chrono::milliseconds(1)));
+#endif
+    }
+
+#ifdef __linux__
+    static_assert(sizeof(std::atomic<std::uint32_t>) == sizeof(std::uint32_t), "El futex espera sobre una palabra de 32 bits");
+
+    std::uint32_t* changes_word() const {
+        return reinterpret_cast<std::uint32_t*>(const_cast<std::atomic<std::uint32_t>*>(&changes));
+    }
+#endif
+
+    std::atomic<T> value;  // Dato compartido
+    mutable std::atomic<int> waiters{0};  // Hilos dentro de wait_for_change
+    std::atomic<std::uint32_t> changes{0};  // Avisos de cambio dados con algún hilo esperando
+};
+
+// Contador repartido en porciones ("shards"), una por línea de caché. Cada hilo incrementa siempre
+// la misma porción, así que con tantas porciones como núcleos los incrementos no se disputan ninguna
+// línea de caché y el rendimiento crece con el número de núcleos. A cambio, leer el valor exacto
+// suma todas las porciones.
+// Para lecturas frecuentes hay un valor aproximado: cada porción vuelca su cuenta en un total común
+// cada 'fold_interval' incrementos, y leerlo es una sola carga. Nunca supera al valor exacto y se queda
+// por detrás como mucho (fold_interval - 1) incrementos por porción
+class ShardedSharedData {
+public:
+    static constexpr std::int64_t fold_interval = 1024;
+
+    // Por defecto, una porción por núcleo redondeada a potencia de dos
+    explicit ShardedSharedData(std::size_t shard_count = std::thread::hardware_concurrency())
+        : mask(std::bit_ceil(std::max<std::size_t>(shard_count, 1)) - 1), shards(new Shard[mask + 1]) {}
+
+    void increment() {
+        Shard& shard = shards[thread_slot() & mask];
+        std::int64_t count = shard.count.fetch_add(1, std::memory_order_relaxed) + 1;
+        if (count % fold_interval == 0) {
+            approximate.fetch_add(fold_interval, std::memory_order_relaxed);  // Un volcado cada fold_interval
+        }
+    }
+
+    // Valor exacto: suma todas las porciones (una línea de caché por porción)
+    std::int64_t get_value() const {
+        std::int64_t total = 0;
+        for (std::size_t i = 0; i <= mask; ++i) {
+            total += shards[i].count.load(std::memory_order_relaxed);
+        }
+        return total;
+    }
+
+    // Valor aproximado por defecto: una sola carga, sin recorrer las porciones
+    std::int64_t get_approximate_value() const {
+        return approximate.load(std::memory_order_relaxed);
+    }
+
+    std::size_t shard_count() const { return mask + 1; }
+
+private:
+    static constexpr std::size_t cache_line_size = 64;
+
+    struct alignas(cache_line_size) Shard {
+        std::atomic<std::int64_t> count{0};
+    };
+
+    // Índice fijo de cada hilo, repartido en turno rotatorio al usarlo por primera vez
+    static std::size_t thread_slot() {
+        static std::atomic<std::size_t> next_slot{0};
+        thread_local std::size_t slot = next_slot.fetch_add(1, std::memory_order_relaxed);
+        return slot;
+    }
+
+    std::size_t mask;
+    std::unique_ptr<Shard[]> shards;
+    alignas(cache_line_size) std::atomic<std::int64_t> approximate{0};
+};
+
+// Versión anterior con mutex, sin E/S dentro de la sección crítica. Se mantiene como referencia
+// para comparar en benchmark_shared_data.cpp
+class MutexSharedData {
+public:
+    MutexSharedData() : value(0) {}
+
+    int increment() {
+        std::lock_guard<std::mutex> lock(mtx); // Asegura la exclusión mutua
+        return ++value;
+    }
+
+    int get_value() {
+        std::lock_guard<std::mutex> lock(mtx); // Asegura la exclusión mutua
+        return value;
+    }
+
+private:
+    int value;                // Dato compartido
+    std::mutex mtx;          // Mutex para proteger el acceso a 'value'
+};
+
+#endif  // SHARED_DATA_H
@@ -0,0 +1,199 @@
+#ifndef ACCOUNT_STORE_H
+#define ACCOUNT_STORE_H
+
+#include <algorithm>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+#include <optional>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include "bank_account.h"
+#include "lock_profiler.h"
+
+using AccountId = std::uint32_t;
+
+// Acción por defecto tras aplicar una operación: ninguna
+struct NoAction {
+    void operator()() const {}
+};
+
+// Almacén de muchas cuentas (millones) identificadas por número, con cerrojos por franjas.
+// Las cuentas se reparten entre 'shard_count' porciones según los bits bajos del número: la cuenta 'id'
+// vive en la porción id % shard_count, en la posición id / shard_count de un vector contiguo de saldos.
+// Cada porción tiene un único mutex que protege todos sus saldos: en vez de un mutex por cuenta (40 bytes
+// por cada 8 de saldo) hay unas decenas en total, y los saldos quedan juntos en memoria. Al repartir por
+// los bits bajos, las cuentas de números consecutivos (a menudo las más activas) caen en porciones distintas
+class AccountStore {
+public:
+    // 'shard_count' se redondea a la siguiente potencia de dos
+    explicit AccountStore(std::size_t account_count, Money initial_balance = 0, std::size_t shard_count = 64)
+        : account_count(account_count),
+          shift(std::countr_zero(std::bit_ceil(std::max<std::size_t>(shard_count, 1)))),
+          shard_mask((std::size_t{1} << shift) - 1),
+          shards(shard_mask + 1) {
+        if (account_count > std::size_t{1} << 32) {
+            throw std::length_error("Demasiadas cuentas para un AccountId de 32 bits");
+        }
+        for (std::size_t s = 0; s < shards.size(); ++s) {
+            shards[s].balances.assign(accounts_in_shard(s), initial_balance);
+            shards[s].mtx.set_name("franja " + std::to_string(s));
+        }
+    }
+
+    AccountStore(const AccountStore&) = delete;
+    AccountStore& operator=(const AccountStore&) = delete;
+
+    std::size_t size() const { return account_count; }
+    std::size_t shard_count() const { return shards.size(); }
+    std::size_t shard_of(AccountId id) const { return id & shard_mask; }
+    bool contains(AccountId id) const { return id < account_count; }
+
+    // Todas las operaciones lanzan std::out_of_range si la cuenta no existe, y las que mueven dinero
+    // std::invalid_argument si el importe es negativo (como BatchTransferEngine, que los marca como Invalid).
+    // Las que modifican saldos aceptan una acción 'on_applied' que se ejecuta solo si la operación se aplica,
+    // todavía con los cerrojos tomados: por ejemplo, para anotarla en un diario en el mismo orden en que
+    // se aplicó a cada cuenta. Si 'on_applied' lanza, la operación se deshace antes de propagar la excepción,
+    // así que el saldo en memoria nunca queda por delante de lo que la acción llegó a registrar
+    Money balance(AccountId id) const {
+        const Shard& shard = shards[shard_of(checked(id))];
+        std::lock_guard<ProfiledMutex> lock(shard.mtx);
+        return shard.balances[id >> shift];
+    }
+
+    // Devuelve el saldo resultante
+    template <typename OnApplied = NoAction>
+    Money deposit(AccountId id, Money amount, OnApplied on_applied = {}) {
+        Shard& shard = shards[shard_of(checked(id))];
+        checked_amount(amount);
+        std::lock_guard<ProfiledMutex> lock(shard.mtx);
+        Money& balance = shard.balances[id >> shift];
+        balance += amount;
+        try {
+            on_applied();
+        } catch (...) {
+            balance -= amount;
+            throw;
+        }
+        return balance;
+    }
+
+    // Devuelve el saldo resultante, o nada si no había fondos suficientes
+    template <typename OnApplied = NoAction>
+    std::optional<Money> withdraw(AccountId id, Money amount, OnApplied on_applied = {}) {
+        Shard& shard = shards[shard_of(checked(id))];
+        checked_amount(amount);
+        std::lock_guard<ProfiledMutex> lock(shard.mtx);
+        Money& balance = shard.balances[id >> shift];
+        std::optional<Money> remaining = debit(balance, amount);
+        if (remaining) {
+            try {
+                on_applied();
+            } catch (...) {
+                balance += amount;
+                throw;
+            }
+        }
+        return remaining;
+    }
+
+    // Devuelve el saldo resultante de 'from', o nada si no había fondos. Si las cuentas están en porciones
+    // distintas se toman los dos cerrojos con std::scoped_lock, que evita el interbloqueo sin ordenarlos a mano
+    template <typename OnApplied = NoAction>
+    std::optional<Money> transfer(AccountId from, AccountId to, Money amount, OnApplied on_applied = {}) {
+        Shard& source = shards[shard_of(checked(from))];
+        Shard& target = shards[shard_of(checked(to))];
+        checked_amount(amount);
+        auto apply = [&]() -> std::optional<Money> {
+            Money& source_balance = source.balances[from >> shift];
+            Money& target_balance = target.balances[to >> shift];
+            std::optional<Money> remaining = debit(source_balance, amount);
+            if (remaining) {
+                target_balance += amount;
+                try {
+                    on_applied();
+                } catch (...) {
+                    target_balance -= amount;
+                    source_balance += amount;
+                    throw;
+                }
+            }
+            return remaining;
+        };
+        if (&source == &target) {
+            std::lock_guard<ProfiledMutex> lock(source.mtx);
+            return apply();
+        }
+        std::scoped_lock lock(source.mtx, target.mtx);
+        return apply();
+    }
+
+    // Suma de todos los saldos. Toma todos los cerrojos a la vez (siempre en el mismo orden), así que el
+    // resultado es una foto coherente: ninguna transferencia queda a medias, tampoco las de un bloque de
+    // BatchTransferEngine, que retiene todos los cerrojos mientras lo aplica
+    Money total() const {
+        std::vector<std::unique_lock<ProfiledMutex>> locks = lock_all_shards();
+        Money sum = 0;
+        for (const Shard& shard : shards) {
+            for (Money balance : shard.balances) {
+                sum += balance;
+            }
+        }
+        return sum;
+    }
+
+private:
+    friend class BatchTransferEngine;
+
+    // Cada porción empieza en su propia línea de caché: los mutex de porciones vecinas no se estorban.
+    // Con -DLOCK_PROFILING cada franja mide sus esperas y aparece en print_hottest_locks como "franja N"
+    struct alignas(64) Shard {
+        mutable ProfiledMutex mtx;
+        std::vector<Money> balances;
+    };
+
+    // Toma los cerrojos de todas las porciones, siempre en el mismo orden
+    std::vector<std::unique_lock<ProfiledMutex>> lock_all_shards() const {
+        std::vector<std::unique_lock<ProfiledMutex>> locks;
+        locks.reserve(shards.size());
+        for (const Shard& shard : shards) {
+            locks.emplace_back(shard.mtx);
+        }
+        return locks;
+    }
+
+    static std::optional<Money> debit(Money& balance, Money amount) {
+        if (balance < amount) {
+            return std::nullopt;
+        }
+        return balance -= amount;
+    }
+
+    AccountId checked(AccountId id) const {
+        if (!contains(id)) {
+            throw std::out_of_range("Cuenta inexistente: " + std::to_string(id));
+        }
+        return id;
+    }
+
+    // Un importe negativo invertiría la operación: una retirada sin comprobar fondos, por ejemplo
+    static void checked_amount(Money amount) {
+        if (amount < 0) {
+            throw std::invalid_argument("Importe negativo: " + format_money(amount));
+        }
+    }
+
+    std::size_t accounts_in_shard(std::size_t shard) const {
+        return shard < account_count ? (account_count - shard + shard_mask) >> shift : 0;
+    }
+
+    std::size_t account_count;
+    int shift;
+    std::size_t shard_mask;
+    std::vector<Shard> shards;
+};
+
+#endif  // ACCOUNT_STORE_H
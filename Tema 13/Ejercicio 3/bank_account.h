@@ -0,0 +1,144 @@
+#ifndef BANK_ACCOUNT_H
+#define BANK_ACCOUNT_H
+
+#include <atomic>
+#include <cstdint>
+#include <cstdlib>
+#include <mutex>
+#include <optional>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <utility>
+
+#include "lock_profiler.h"
+
+// Importe en unidades menores (céntimos). Con enteros las sumas y restas son exactas:
+// no hay deriva de redondeo como al acumular 0.10 en un double
+using Money = std::int64_t;
+
+// Convierte unidades enteras (dólares, euros...) a céntimos
+constexpr Money from_units(std::int64_t units) { return units * 100; }
+
+// Texto con dos decimales, por ejemplo 25050 -> "250.50"
+inline std::string format_money(Money amount) {
+    std::string sign = amount < 0 ? "-" : "";
+    std::int64_t magnitude = std::llabs(amount);
+    std::int64_t cents = magnitude % 100;
+    return sign + std::to_string(magnitude / 100) + (cents < 10 ? ".0" : ".") + std::to_string(cents);
+}
+
+// Cuenta bancaria sin cerrojos: el saldo es un único entero atómico.
+// Ingresar es un fetch_add; retirar es un bucle compare-exchange que solo resta si hay fondos, así que
+// el saldo nunca queda negativo aunque varios hilos retiren a la vez. Leer el saldo es una carga atómica.
+// El saldo no publica ningún otro dato, así que basta con orden relaxed.
+// Las transferencias sí toman un cerrojo por cuenta: mover dinero entre dos saldos no cabe en una sola
+// operación atómica, y así quien lea las dos cuentas con balances() nunca ve una transferencia a medias.
+// Con -DLOCK_PROFILING ese cerrojo mide sus esperas y aparece en print_hottest_locks con el nombre de la cuenta.
+// Las operaciones que mueven dinero lanzan std::invalid_argument si el importe es negativo, como AccountStore
+class BankAccount {
+public:
+    explicit BankAccount(Money initial_balance = 0, std::string_view name = "cuenta")
+        : balance(initial_balance), transfer_mtx(name) {}
+
+    BankAccount(const BankAccount&) = delete;
+    BankAccount& operator=(const BankAccount&) = delete;
+
+    Money getBalance() const { return balance.load(std::memory_order_relaxed); }
+
+    // Devuelve el saldo resultante
+    Money deposit(Money amount) {
+        checked_amount(amount);
+        return balance.fetch_add(amount, std::memory_order_relaxed) + amount;
+    }
+
+    // Devuelve el saldo resultante, o nada si no había fondos suficientes (y entonces no se toca el saldo)
+    std::optional<Money> withdraw(Money amount) {
+        checked_amount(amount);
+        Money current = balance.load(std::memory_order_relaxed);
+        do {
+            if (current < amount) {
+                return std::nullopt;
+            }
+        } while (!balance.compare_exchange_weak(current, current - amount, std::memory_order_relaxed));
+        return current - amount;
+    }
+
+    // Retira de esta cuenta e ingresa en 'to' con los cerrojos de las dos cuentas tomados, siempre en el
+    // mismo orden (por dirección) para que dos transferencias cruzadas no se interbloqueen. Devuelve el saldo
+    // resultante de esta cuenta, o nada si no había fondos. Los ingresos y retiradas sueltos no esperan a
+    // este cerrojo: solo cambian una cuenta y siguen siendo operaciones atómicas
+    std::optional<Money> transfer(BankAccount& to, Money amount) {
+        checked_amount(amount);
+        if (&to == this) {  // El dinero no se mueve: solo se comprueban los fondos
+            Money current = getBalance();
+            return current >= amount ? std::optional<Money>(current) : std::nullopt;
+        }
+        BankAccount* first = this < &to ? this : &to;
+        BankAccount* second = this < &to ? &to : this;
+        std::scoped_lock lock(first->transfer_mtx, second->transfer_mtx);
+        std::optional<Money> remaining = withdraw(amount);
+        if (remaining) {
+            to.deposit(amount);
+        }
+        return remaining;
+    }
+
+    // Saldos de dos cuentas leídos a la vez: ninguna transferencia entre ellas está a medias.
+    // Si son la misma cuenta se toma un solo cerrojo (tomar dos veces el mismo mutex es un interbloqueo)
+    friend std::pair<Money, Money> balances(const BankAccount& a, const BankAccount& b) {
+        if (&a == &b) {
+            std::lock_guard<ProfiledMutex> lock(a.transfer_mtx);
+            Money current = a.getBalance();
+            return {current, current};
+        }
+        const BankAccount* first = &a < &b ? &a : &b;
+        const BankAccount* second = &a < &b ? &b : &a;
+        std::scoped_lock lock(first->transfer_mtx, second->transfer_mtx);
+        return {a.getBalance(), b.getBalance()};
+    }
+
+private:
+    // Un importe negativo invertiría la operación: una retirada que ingresa sin comprobar nada, por ejemplo
+    static void checked_amount(Money amount) {
+        if (amount < 0) {
+            throw std::invalid_argument("Importe negativo: " + format_money(amount));
+        }
+    }
+
+    std::atomic<Money> balance;
+    mutable ProfiledMutex transfer_mtx;  // Solo lo toman transfer() y balances()
+    static_assert(std::atomic<Money>::is_always_lock_free);
+};
+
+// Versión anterior, protegida con un mutex, conservada para comparar
+class MutexBankAccount {
+public:
+    explicit MutexBankAccount(Money initial_balance = 0) : balance(initial_balance) {}
+
+    Money getBalance() {
+        std::lock_guard<std::mutex> lock(mtx);  // Sincronización para lectura
+        return balance;
+    }
+
+    Money deposit(Money amount) {
+        std::lock_guard<std::mutex> lock(mtx);
+        balance += amount;
+        return balance;
+    }
+
+    std::optional<Money> withdraw(Money amount) {
+        std::lock_guard<std::mutex> lock(mtx);
+        if (balance < amount) {
+            return std::nullopt;
+        }
+        balance -= amount;
+        return balance;
+    }
+
+private:
+    Money balance;
+    std::mutex mtx;  // Mutex para proteger el acceso al balance
+};
+
+#endif  // BANK_ACCOUNT_H
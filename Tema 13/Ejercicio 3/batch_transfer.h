@@ -0,0 +1,180 @@
+#ifndef BATCH_TRANSFER_H
+#define BATCH_TRANSFER_H
+
+#include <algorithm>
+#include <atomic>
+#include <barrier>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <mutex>
+#include <span>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+
+#include "account_store.h"
+
+struct Transfer {
+    AccountId from;
+    AccountId to;
+    Money amount;
+};
+
+enum class TransferStatus : std::uint8_t {
+    Applied,
+    InsufficientFunds,
+    Invalid  // Cuenta inexistente o importe negativo
+};
+
+// Aplica bloques de transferencias en paralelo sobre un AccountStore, con un resultado que solo depende
+// del bloque y de los saldos iniciales, nunca del número de hilos ni de cómo se intercalen.
+// Cada bloque se procesa en tres fases separadas por barreras:
+//   1. Reparto: cada hilo recorre un tramo del bloque y apunta cada transferencia en la porción de la
+//      cuenta de origen.
+//   2. Cargos: cada porción la procesa un solo hilo, que recorre sus transferencias en el orden del bloque
+//      y resta el importe si hay fondos. Los abonos aceptados se apuntan para la porción de destino.
+//   3. Abonos: cada porción de destino suma lo que le corresponde. Las sumas conmutan, así que el orden da igual.
+// Entre el primer cargo y el último abono hay dinero en tránsito, así que apply() toma los cerrojos de todas
+// las porciones al empezar y no los suelta hasta terminar el bloque: las operaciones sueltas del almacén y
+// total() esperan a que acabe, nunca ven el bloque a medias ni cambian su resultado. Dentro del bloque las
+// fases no necesitan cerrojos: cada porción la toca un solo hilo por fase y las barreras ordenan los accesos,
+// por muy sesgada que esté la carga. A cambio, lo recibido durante un bloque solo se puede gastar a partir del bloque siguiente
+// (como en una liquidación por lotes): una cuenta solo puede pagar con el saldo que tenía al empezar el bloque.
+// Los hilos se crean una vez y se reutilizan para todos los bloques; el hilo que llama a apply() trabaja también
+class BatchTransferEngine {
+public:
+    explicit BatchTransferEngine(AccountStore& store, unsigned thread_count = std::thread::hardware_concurrency())
+        : store(store),
+          worker_count(std::max(thread_count, 1u)),
+          sync(worker_count),
+          debits(worker_count, std::vector<std::vector<std::uint32_t>>(store.shard_count())),
+          credits(store.shard_count(), std::vector<std::vector<Credit>>(store.shard_count())) {
+        for (unsigned i = 1; i < worker_count; ++i) {
+            workers.emplace_back(&BatchTransferEngine::worker_loop, this, i);
+        }
+    }
+
+    BatchTransferEngine(const BatchTransferEngine&) = delete;
+    BatchTransferEngine& operator=(const BatchTransferEngine&) = delete;
+
+    ~BatchTransferEngine() {
+        stopping = true;
+        sync.arrive_and_wait();  // Despierta a los hilos para que vean 'stopping'
+        for (auto& worker : workers) {
+            worker.join();
+        }
+    }
+
+    unsigned thread_count() const { return worker_count; }
+
+    // Aplica el bloque y devuelve el resultado de cada transferencia, en el mismo orden.
+    // Se puede llamar desde varios hilos: los bloques se aplican de uno en uno
+    std::vector<TransferStatus> apply(std::span<const Transfer> batch) {
+        if (batch.size() > std::numeric_limits<std::uint32_t>::max()) {
+            throw std::length_error("Bloque de transferencias demasiado grande");
+        }
+        std::lock_guard<std::mutex> lock(apply_mtx);
+        std::vector<std::unique_lock<ProfiledMutex>> shard_locks = store.lock_all_shards();
+        std::vector<TransferStatus> statuses(batch.size(), TransferStatus::Applied);
+        current_batch = batch;
+        current_statuses = statuses.data();
+        next_debit_shard.store(0, std::memory_order_relaxed);
+        next_credit_shard.store(0, std::memory_order_relaxed);
+        sync.arrive_and_wait();  // Arranque
+        run_phases(0);
+        return statuses;
+    }
+
+private:
+    struct Credit {
+        std::uint32_t index;  // Posición de la cuenta de destino dentro de su porción
+        Money amount;
+    };
+
+    void worker_loop(unsigned worker) {
+        while (true) {
+            sync.arrive_and_wait();  // Espera a que haya un bloque (o a que el motor se destruya)
+            if (stopping) {
+                return;
+            }
+            run_phases(worker);
+        }
+    }
+
+    void run_phases(unsigned worker) {
+        distribute(worker);
+        sync.arrive_and_wait();
+        for (std::size_t shard; (shard = next_debit_shard.fetch_add(1, std::memory_order_relaxed)) < store.shard_count();) {
+            apply_debits(shard);
+        }
+        sync.arrive_and_wait();
+        for (std::size_t shard; (shard = next_credit_shard.fetch_add(1, std::memory_order_relaxed)) < store.shard_count();) {
+            apply_credits(shard);
+        }
+        sync.arrive_and_wait();
+    }
+
+    // Fase 1: los tramos son contiguos y crecientes, así que al concatenarlos por orden de hilo cada porción
+    // recibe sus transferencias en el orden del bloque
+    void distribute(unsigned worker) {
+        std::size_t begin = current_batch.size() * worker / worker_count;
+        std::size_t end = current_batch.size() * (worker + 1) / worker_count;
+        std::vector<std::vector<std::uint32_t>>& own = debits[worker];
+        for (std::size_t i = begin; i < end; ++i) {
+            const Transfer& transfer = current_batch[i];
+            if (!store.contains(transfer.from) || !store.contains(transfer.to) || transfer.amount < 0) {
+                current_statuses[i] = TransferStatus::Invalid;
+                continue;
+            }
+            own[store.shard_of(transfer.from)].push_back(static_cast<std::uint32_t>(i));
+        }
+    }
+
+    // Fase 2: el resultado de cada cargo depende solo de los cargos anteriores de la misma porción.
+    // El cerrojo de la porción lo tiene apply() durante todo el bloque
+    void apply_debits(std::size_t shard_index) {
+        AccountStore::Shard& shard = store.shards[shard_index];
+        for (auto& pending : debits) {
+            for (std::uint32_t i : pending[shard_index]) {
+                const Transfer& transfer = current_batch[i];
+                Money& balance = shard.balances[transfer.from >> store.shift];
+                if (balance < transfer.amount) {
+                    current_statuses[i] = TransferStatus::InsufficientFunds;
+                    continue;
+                }
+                balance -= transfer.amount;
+                credits[shard_index][store.shard_of(transfer.to)].push_back(
+                    {static_cast<std::uint32_t>(transfer.to >> store.shift), transfer.amount});
+            }
+            pending[shard_index].clear();  // Conserva la capacidad para el siguiente bloque
+        }
+    }
+
+    // Fase 3
+    void apply_credits(std::size_t shard_index) {
+        AccountStore::Shard& shard = store.shards[shard_index];
+        for (auto& from_shard : credits) {
+            for (const Credit& credit : from_shard[shard_index]) {
+                shard.balances[credit.index] += credit.amount;
+            }
+            from_shard[shard_index].clear();
+        }
+    }
+
+    AccountStore& store;
+    unsigned worker_count;
+    std::barrier<> sync;
+    std::vector<std::thread> workers;
+    bool stopping = false;  // Se escribe antes de una barrera y se lee después: la barrera ordena el acceso
+
+    std::mutex apply_mtx;
+    std::span<const Transfer> current_batch;
+    TransferStatus* current_statuses = nullptr;
+    std::atomic<std::size_t> next_debit_shard{0};   // Reparto dinámico: una porción muy cargada no frena
+    std::atomic<std::size_t> next_credit_shard{0};  // a los demás hilos, que siguen con otras porciones
+    std::vector<std::vector<std::vector<std::uint32_t>>> debits;  // [hilo][porción de origen] -> posiciones
+    std::vector<std::vector<std::vector<Credit>>> credits;        // [porción de origen][porción de destino]
+};
+
+#endif  // BATCH_TRANSFER_H
@@ -0,0 +1,154 @@
+// Benchmark: transferencias por segundo entre millones de cuentas, una a una con cerrojos por franjas
+// frente a bloques en paralelo, con carga uniforme y sesgada (Zipf), según el número de hilos
+// Compilar: g++ -std=c++20 -O2 -pthread benchmark_account_store.cpp -o benchmark_account_store
+#include <iostream>
+#include <iomanip>
+#include <atomic>
+#include <chrono>
+#include <random>
+#include <thread>
+#include <vector>
+
+#include "account_store.h"
+#include "batch_transfer.h"
+#include "zipf_generator.h"
+
+using BenchmarkClock = std::chrono::steady_clock;
+
+const std::size_t account_count = 2'000'000;
+const Money initial_balance = from_units(100);
+const std::size_t batch_size = 65'536;
+const std::size_t batch_count = 32;
+
+std::vector<Transfer> make_transfers(double exponent) {
+    ZipfGenerator accounts(account_count, exponent);
+    std::mt19937_64 random(42);
+    std::uniform_int_distribution<Money> amount(1, from_units(60));
+    std::vector<Transfer> transfers(batch_size * batch_count);
+    for (Transfer& transfer : transfers) {
+        transfer = {accounts(random), accounts(random), amount(random)};
+    }
+    return transfers;
+}
+
+// Huella de los saldos y resultados, para comprobar que dos ejecuciones acaban igual
+struct Outcome {
+    std::uint64_t fingerprint = 0;
+    std::size_t applied = 0;
+    bool conserved = true;
+};
+
+std::uint64_t mix(std::uint64_t hash, std::uint64_t value) { return (hash ^ value) * 0x100000001B3ULL; }
+
+Outcome fingerprint(const AccountStore& store, const std::vector<TransferStatus>& statuses) {
+    Outcome outcome;
+    for (AccountId id = 0; id < store.size(); ++id) {
+        outcome.fingerprint = mix(outcome.fingerprint, static_cast<std::uint64_t>(store.balance(id)));
+    }
+    for (TransferStatus status : statuses) {
+        outcome.fingerprint = mix(outcome.fingerprint, static_cast<std::uint64_t>(status));
+        outcome.applied += status == TransferStatus::Applied;
+    }
+    outcome.conserved = store.total() == initial_balance * static_cast<Money>(account_count);
+    return outcome;
+}
+
+// Millones de transferencias por segundo aplicando los bloques con 'thread_count' hilos
+double run_batches(const std::vector<Transfer>& transfers, unsigned thread_count, Outcome& outcome) {
+    AccountStore store(account_count, initial_balance);
+    BatchTransferEngine engine(store, thread_count);
+    std::vector<TransferStatus> statuses;
+    statuses.reserve(transfers.size());
+    auto start = BenchmarkClock::now();
+    for (std::size_t b = 0; b < batch_count; ++b) {
+        std::span<const Transfer> batch(transfers.data() + b * batch_size, batch_size);
+        std::vector<TransferStatus> batch_statuses = engine.apply(batch);
+        statuses.insert(statuses.end(), batch_statuses.begin(), batch_statuses.end());
+    }
+    std::chrono::duration<double> elapsed = BenchmarkClock::now() - start;
+    outcome = fingerprint(store, statuses);
+    return transfers.size() / elapsed.count() / 1e6;
+}
+
+// Lo mismo, pero cada hilo aplica su parte una a una con AccountStore::transfer (resultado no determinista)
+double run_individual(const std::vector<Transfer>& transfers, unsigned thread_count) {
+    AccountStore store(account_count, initial_balance);
+    std::vector<std::thread> threads;
+    auto start = BenchmarkClock::now();
+    for (unsigned t = 0; t < thread_count; ++t) {
+        threads.emplace_back([&, t] {
+            for (std::size_t i = t; i < transfers.size(); i += thread_count) {
+                store.transfer(transfers[i].from, transfers[i].to, transfers[i].amount);
+            }
+        });
+    }
+    for (auto& thread : threads) {
+        thread.join();
+    }
+    std::chrono::duration<double> elapsed = BenchmarkClock::now() - start;
+    if (store.total() != initial_balance * static_cast<Money>(account_count)) {
+        std::cerr << "El dinero total ha cambiado" << std::endl;
+    }
+    return transfers.size() / elapsed.count() / 1e6;
+}
+
+// Un hilo aplica bloques mientras otro suma los saldos con total(): como apply() retiene todos los cerrojos,
+// total() nunca ve dinero en tránsito entre el cargo y el abono
+bool check_total_during_batches(const std::vector<Transfer>& transfers) {
+    const std::size_t small_count = 10'000;
+    const Money expected = initial_balance * static_cast<Money>(small_count);
+    AccountStore store(small_count, initial_balance, 16);
+    BatchTransferEngine engine(store, 2);
+    std::vector<Transfer> batch(batch_size);
+    for (std::size_t i = 0; i < batch.size(); ++i) {
+        batch[i] = {static_cast<AccountId>(transfers[i].from % small_count),
+                    static_cast<AccountId>(transfers[i].to % small_count), transfers[i].amount};
+    }
+    std::atomic<bool> done{false};
+    bool conserved = true;
+    std::thread observer([&] {
+        while (!done.load(std::memory_order_relaxed)) {
+            conserved = conserved && store.total() == expected;
+        }
+    });
+    for (int b = 0; b < 50; ++b) {
+        engine.apply(batch);
+    }
+    done = true;
+    observer.join();
+    return conserved && store.total() == expected;
+}
+
+int main() {
+    std::cout << std::thread::hardware_concurrency() << " núcleo(s), " << account_count << " cuentas, "
+              << batch_count << " bloques de " << batch_size << " transferencias\n";
+    std::vector<Transfer> uniform = make_transfers(0.0);
+    std::vector<Transfer> skewed = make_transfers(0.99);
+
+    bool deterministic = true;
+    Outcome uniform_reference, skewed_reference;
+    std::cout << std::setw(8) << "hilos" << std::setw(22) << "una a una Zipf (M/s)" << std::setw(22)
+              << "bloques unif. (M/s)" << std::setw(20) << "bloques Zipf (M/s)" << "\n";
+    for (unsigned threads : {1u, 2u, 4u, 8u}) {
+        double individual = run_individual(skewed, threads);
+        Outcome uniform_outcome, skewed_outcome;
+        double batched_uniform = run_batches(uniform, threads, uniform_outcome);
+        double batched_skewed = run_batches(skewed, threads, skewed_outcome);
+        if (threads == 1) {
+            uniform_reference = uniform_outcome;
+            skewed_reference = skewed_outcome;
+        }
+        deterministic = deterministic && uniform_outcome.conserved && skewed_outcome.conserved &&
+                        uniform_outcome.fingerprint == uniform_reference.fingerprint &&
+                        skewed_outcome.fingerprint == skewed_reference.fingerprint;
+        std::cout << std::setw(8) << threads << std::fixed << std::setprecision(2) << std::setw(22) << individual
+                  << std::setw(22) << batched_uniform << std::setw(20) << batched_skewed << "\n";
+    }
+
+    std::cout << "Aceptadas: " << uniform_reference.applied << " (uniforme), " << skewed_reference.applied
+              << " (Zipf) de " << uniform.size() << "\n";
+    std::cout << "Mismo resultado con cualquier número de hilos: " << (deterministic ? "sí" : "NO") << "\n";
+    bool consistent_total = check_total_during_batches(skewed);
+    std::cout << "total() durante los bloques sin dinero en tránsito: " << (consistent_total ? "sí" : "NO") << "\n";
+    return deterministic && consistent_total ? 0 : 1;
+}
@@ -0,0 +1,161 @@
+// Benchmark: ingresos y retiradas concurrentes en una misma cuenta con mutex y con saldo atómico
+// Compilar: g++ -std=c++20 -O2 -pthread benchmark_bank_account.cpp -o benchmark_bank_account
+// Con -DLOCK_PROFILING se informa además de las esperas en los cerrojos de las transferencias cruzadas
+#include <iostream>
+#include <iomanip>
+#include <chrono>
+#include <thread>
+#include <vector>
+#include <atomic>
+#include <stdexcept>
+
+#include "bank_account.h"
+
+using BenchmarkClock = std::chrono::steady_clock;
+
+// Cada hilo alterna un ingreso y una retirada del mismo importe sobre una cuenta compartida (el caso de
+// máxima contención). Devuelve millones de operaciones por segundo. Al terminar, el saldo debe ser el inicial
+template <typename Account>
+double run_benchmark(unsigned thread_count, int pairs_per_thread) {
+    const Money initial = from_units(1000);
+    Account account(initial);
+    std::atomic<bool> go{false};
+    std::atomic<long long> rejected{0};
+    std::vector<std::thread> threads;
+    for (unsigned i = 0; i < thread_count; ++i) {
+        threads.emplace_back([&] {
+            while (!go.load(std::memory_order_acquire)) {
+                std::this_thread::yield();
+            }
+            long long local_rejected = 0;
+            for (int j = 0; j < pairs_per_thread; ++j) {
+                account.deposit(7);
+                if (!account.withdraw(7)) {
+                    ++local_rejected;
+                }
+                account.getBalance();
+            }
+            rejected.fetch_add(local_rejected, std::memory_order_relaxed);
+        });
+    }
+    auto start = BenchmarkClock::now();
+    go.store(true, std::memory_order_release);
+    for (auto& thread : threads) {
+        thread.join();
+    }
+    std::chrono::duration<double> elapsed = BenchmarkClock::now() - start;
+
+    if (rejected.load() != 0 || account.getBalance() != initial) {
+        std::cerr << "Saldo incoherente: " << format_money(account.getBalance()) << ", retiradas rechazadas: "
+                  << rejected.load() << std::endl;
+    }
+    return 3.0 * thread_count * pairs_per_thread / elapsed.count() / 1e6;
+}
+
+// Varios hilos intentan retirar más de lo que hay: la suma retirada nunca supera el saldo inicial
+bool check_no_overdraft() {
+    BankAccount account(from_units(10));
+    std::atomic<Money> withdrawn{0};
+    std::vector<std::thread> threads;
+    for (int i = 0; i < 8; ++i) {
+        threads.emplace_back([&] {
+            for (int j = 0; j < 1000; ++j) {
+                if (account.withdraw(3)) {
+                    withdrawn.fetch_add(3, std::memory_order_relaxed);
+                }
+            }
+        });
+    }
+    for (auto& thread : threads) {
+        thread.join();
+    }
+    return account.getBalance() >= 0 && account.getBalance() + withdrawn.load() == from_units(10);
+}
+
+// Dos hilos se transfieren dinero en sentidos opuestos (sin interbloquearse) mientras otro lee las dos cuentas
+// con balances(): la suma nunca cambia, ninguna transferencia se ve a medias
+bool check_atomic_transfers() {
+    const Money total = from_units(200);
+    BankAccount a(total / 2, "cuenta a");
+    BankAccount b(total / 2, "cuenta b");
+    std::atomic<bool> done{false};
+    std::vector<std::thread> threads;
+    threads.emplace_back([&] {
+        for (int i = 0; i < 100'000; ++i) {
+            a.transfer(b, 7);
+        }
+    });
+    threads.emplace_back([&] {
+        for (int i = 0; i < 100'000; ++i) {
+            b.transfer(a, 7);
+        }
+    });
+    bool consistent = true;
+    std::thread observer([&] {
+        while (!done.load(std::memory_order_relaxed)) {
+            auto [balance_a, balance_b] = balances(a, b);
+            consistent = consistent && balance_a + balance_b == total;
+        }
+    });
+    for (auto& thread : threads) {
+        thread.join();
+    }
+    done = true;
+    observer.join();
+    print_hottest_locks(std::cout, 2);
+    return consistent && a.getBalance() + b.getBalance() == total;
+}
+
+// Los importes negativos se rechazan sin tocar ningún saldo, y balances() de una cuenta consigo misma no se
+// interbloquea
+bool check_invalid_calls() {
+    BankAccount a(from_units(10));
+    BankAccount b(from_units(10));
+    auto rejected = [](auto operation) {
+        try {
+            operation();
+        } catch (const std::invalid_argument&) {
+            return true;
+        }
+        return false;
+    };
+    bool ok = rejected([&] { a.deposit(-from_units(20)); });
+    ok = rejected([&] { a.withdraw(-from_units(5)); }) && ok;
+    ok = rejected([&] { a.transfer(b, -from_units(5)); }) && ok;
+    auto [same_a, same_b] = balances(a, a);
+    return ok && a.getBalance() == from_units(10) && b.getBalance() == from_units(10) && same_a == from_units(10) &&
+           same_b == from_units(10);
+}
+
+int main() {
+    const int pairs_per_thread = 200'000;
+
+    // Deriva del punto flotante: un millón de ingresos de 0.10
+    double double_balance = 0.0;
+    Money integer_balance = 0;
+    for (int i = 0; i < 1'000'000; ++i) {
+        double_balance += 0.10;
+        integer_balance += 10;
+    }
+    std::cout << std::fixed << std::setprecision(6) << "Un millón de ingresos de 0.10: double = " << double_balance
+              << ", céntimos = " << format_money(integer_balance) << "\n";
+
+    std::cout << std::thread::hardware_concurrency() << " núcleo(s), " << pairs_per_thread
+              << " ingresos, retiradas y consultas por hilo\n";
+    std::cout << std::setw(8) << "hilos" << std::setw(16) << "mutex (M/s)" << std::setw(16) << "atómico (M/s)" << "\n";
+    for (unsigned threads : {1u, 2u, 4u, 8u, 16u}) {
+        double with_mutex = run_benchmark<MutexBankAccount>(threads, pairs_per_thread);
+        double with_atomic = run_benchmark<BankAccount>(threads, pairs_per_thread);
+        std::cout << std::setw(8) << threads << std::fixed << std::setprecision(2)
+                  << std::setw(16) << with_mutex << std::setw(16) << with_atomic << "\n";
+    }
+
+    bool no_overdraft = check_no_overdraft();
+    std::cout << "Retiradas concurrentes sin descubierto: " << (no_overdraft ? "sí" : "NO") << "\n";
+    bool atomic_transfers = check_atomic_transfers();
+    std::cout << "Transferencias cruzadas atómicas y sin interbloqueo: " << (atomic_transfers ? "sí" : "NO") << "\n";
+    bool invalid_calls = check_invalid_calls();
+    std::cout << "Importes negativos rechazados y balances() de una misma cuenta: " << (invalid_calls ? "sí" : "NO")
+              << "\n";
+    return no_overdraft && atomic_transfers && invalid_calls ? 0 : 1;
+}
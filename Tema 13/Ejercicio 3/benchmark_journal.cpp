@@ -0,0 +1,172 @@
+// Benchmark: transferencias durables por segundo con el diario y escritura agrupada ("group commit"),
+// para varios plazos de agrupación, y comprobación de que al reabrir se reconstruyen los saldos
+// Compilar: g++ -std=c++20 -O2 -pthread benchmark_journal.cpp -o benchmark_journal
+#include <iostream>
+#include <iomanip>
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <random>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "durable_ledger.h"
+
+using BenchmarkClock = std::chrono::steady_clock;
+
+const std::string journal_path = "benchmark_journal.wal";
+const std::size_t account_count = 100'000;
+const Money initial_balance = from_units(100);
+const std::chrono::milliseconds run_time(1000);
+
+struct RunResult {
+    double transfers_per_second = 0.0;
+    double mean_latency_ms = 0.0;
+    JournalStats journal;
+};
+
+// 'client_count' hilos hacen transferencias durables durante 'run_time'; cada una vuelve cuando está en disco
+RunResult run(unsigned client_count, GroupCommitConfig config) {
+    std::remove(journal_path.c_str());
+    DurableLedger ledger(journal_path, account_count, initial_balance, config);
+    std::atomic<bool> stop{false};
+    std::atomic<std::uint64_t> completed{0};
+    std::atomic<std::int64_t> latency_ns{0};
+    std::vector<std::thread> clients;
+    auto start = BenchmarkClock::now();
+    for (unsigned c = 0; c < client_count; ++c) {
+        clients.emplace_back([&, c] {
+            std::mt19937 random(c);
+            std::uniform_int_distribution<AccountId> account(0, account_count - 1);
+            std::uniform_int_distribution<Money> amount(1, from_units(5));
+            std::uint64_t local_completed = 0;
+            std::int64_t local_latency = 0;
+            while (!stop.load(std::memory_order_relaxed)) {
+                auto begin = BenchmarkClock::now();
+                ledger.transfer(account(random), account(random), amount(random));
+                local_latency += std::chrono::nanoseconds(BenchmarkClock::now() - begin).count();
+                ++local_completed;
+            }
+            completed.fetch_add(local_completed);
+            latency_ns.fetch_add(local_latency);
+        });
+    }
+    std::this_thread::sleep_for(run_time);
+    stop = true;
+    for (auto& client : clients) {
+        client.join();
+    }
+    std::chrono::duration<double> elapsed = BenchmarkClock::now() - start;
+
+    RunResult result;
+    result.transfers_per_second = completed.load() / elapsed.count();
+    result.mean_latency_ms = completed.load() == 0 ? 0.0 : latency_ns.load() / 1e6 / completed.load();
+    result.journal = ledger.journal_stats();
+    return result;
+}
+
+void print_row(const std::string& label, unsigned clients, const RunResult& result) {
+    std::cout << std::left << std::setw(24) << label << std::right << std::setw(9) << clients << std::fixed
+              << std::setprecision(0) << std::setw(16) << result.transfers_per_second << std::setw(12)
+              << result.journal.syncs << std::setprecision(1) << std::setw(14) << result.journal.records_per_sync()
+              << std::setprecision(3) << std::setw(16) << result.mean_latency_ms << "\n";
+}
+
+// Escribe transferencias, cierra, añade un registro a medio escribir y reabre: los saldos deben coincidir.
+// Después comprueba que un hueco en el diario no resucita los registros que había detrás
+bool check_replay() {
+    std::remove(journal_path.c_str());
+    std::vector<Money> expected(account_count);
+    std::uint64_t operations = 0;
+    {
+        DurableLedger ledger(journal_path, account_count, initial_balance, {std::chrono::microseconds(0), 4096});
+        std::mt19937 random(7);
+        std::uniform_int_distribution<AccountId> account(0, account_count - 1);
+        for (int i = 0; i < 20'000; ++i) {
+            AccountId id = account(random);
+            switch (i % 3) {
+            case 0: ledger.deposit(id, 250); break;
+            case 1: ledger.withdraw(id, from_units(150)); break;  // Muchas se rechazan
+            default: ledger.transfer(id, account(random), from_units(30)); break;
+            }
+        }
+        for (AccountId id = 0; id < account_count; ++id) {
+            expected[id] = ledger.balance(id);
+        }
+        operations = ledger.journal_stats().records;
+    }
+    {
+        // Simula una caída en mitad de una escritura: basura con apariencia de registro tras el último válido
+        std::FILE* file = std::fopen(journal_path.c_str(), "r+b");
+        JournalRecord torn{operations + 1, JournalOperation::Deposit, 12345, 1, 0, from_units(1'000'000)};
+        std::fseek(file, static_cast<long>(operations * sizeof(JournalRecord)), SEEK_SET);
+        std::fwrite(&torn, sizeof(torn), 1, file);
+        std::fclose(file);
+    }
+    bool same = false;
+    {
+        DurableLedger reopened(journal_path, account_count, initial_balance);
+        same = reopened.replayed_count() == operations;
+        for (AccountId id = 0; id < account_count && same; ++id) {
+            same = reopened.balance(id) == expected[id];
+        }
+        std::cout << "Reapertura: " << reopened.replayed_count() << " de " << operations
+                  << " operaciones repetidas, saldos " << (same ? "idénticos" : "DISTINTOS") << "\n";
+    }
+
+    // Hueco en mitad del diario: se pierden los registros 11 a 15 de 20. Al reabrir solo valen los 10
+    // primeros; las 5 anotaciones siguientes rellenan el hueco y, si los registros 16 a 20 no se hubieran
+    // borrado, la siguiente reapertura los tomaría por válidos y repetiría sus ingresos
+    std::remove(journal_path.c_str());
+    {
+        DurableLedger ledger(journal_path, account_count, initial_balance, {std::chrono::microseconds(0), 4096});
+        for (AccountId id = 1; id <= 20; ++id) {
+            ledger.deposit(id, from_units(id));
+        }
+    }
+    {
+        std::FILE* file = std::fopen(journal_path.c_str(), "r+b");
+        std::vector<JournalRecord> lost(5, JournalRecord{});
+        std::fseek(file, static_cast<long>(10 * sizeof(JournalRecord)), SEEK_SET);
+        std::fwrite(lost.data(), sizeof(JournalRecord), lost.size(), file);
+        std::fclose(file);
+    }
+    {
+        DurableLedger ledger(journal_path, account_count, initial_balance, {std::chrono::microseconds(0), 4096});
+        for (AccountId id = 21; id <= 25; ++id) {
+            ledger.deposit(id, from_units(id));
+        }
+    }
+    DurableLedger refilled(journal_path, account_count, initial_balance);
+    bool no_phantoms = refilled.replayed_count() == 15;
+    for (AccountId id = 1; id <= 25 && no_phantoms; ++id) {
+        bool kept = id <= 10 || id > 20;
+        no_phantoms = refilled.balance(id) == initial_balance + (kept ? from_units(id) : 0);
+    }
+    std::cout << "Hueco rellenado: " << refilled.replayed_count() << " de 15 operaciones repetidas, "
+              << (no_phantoms ? "sin" : "CON") << " ingresos fantasma\n";
+    return same && no_phantoms;
+}
+
+int main() {
+    std::cout << account_count << " cuentas, " << run_time.count() << " ms por prueba\n";
+    std::cout << std::left << std::setw(24) << "plazo de agrupación" << std::right << std::setw(9) << "clientes"
+              << std::setw(16) << "transf./s" << std::setw(12) << "fdatasync" << std::setw(14) << "op/fdatasync"
+              << std::setw(16) << "latencia (ms)" << "\n";
+
+    // Referencia: un único cliente, así que cada transferencia paga su propio fdatasync
+    print_row("sin agrupar", 1, run(1, {std::chrono::microseconds(0), 1}));
+    // Con los clientes esperando su confirmación, un grupo no pasa de 64 operaciones: si el lote máximo es
+    // mayor, cada grupo agota el plazo entero. Con lote máximo 64 se escribe en cuanto están todos
+    for (std::size_t max_batch : {std::size_t{4096}, std::size_t{64}}) {
+        for (auto delay : {0, 200, 1000, 5000}) {
+            GroupCommitConfig config{std::chrono::microseconds(delay), max_batch};
+            print_row(std::to_string(delay) + " us, lote " + std::to_string(max_batch), 64, run(64, config));
+        }
+    }
+
+    bool replay_ok = check_replay();
+    std::remove(journal_path.c_str());
+    return replay_ok ? 0 : 1;
+}
@@ -0,0 +1,92 @@
+#ifndef DURABLE_LEDGER_H
+#define DURABLE_LEDGER_H
+
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <string>
+
+#include "account_store.h"
+#include "journal.h"
+
+// Almacén de cuentas cuyas operaciones sobreviven a una caída. Cada operación se aplica en memoria, se anota
+// en el diario con los cerrojos de sus cuentas todavía tomados (así el diario respeta el orden de cada cuenta)
+// y, ya sin cerrojos, espera a que el diario la confirme en disco antes de devolver el resultado. El diario
+// va por detrás de la memoria, no por delante: lo que se adelanta a la caída es la confirmación al cliente.
+// Si no se puede anotar (el diario no puede crecer), AccountStore deshace la operación antes de propagar
+// el error, de modo que memoria y diario no divergen.
+// Otros hilos pueden ver un saldo en memoria antes de que sea durable, pero nadie recibe la confirmación
+// de una operación que una caída pudiera borrar. Solo se anotan las operaciones aplicadas: las rechazadas
+// no cambian nada.
+// Al abrir, se parte de los saldos iniciales y se repiten las operaciones del diario. Los saldos iniciales
+// deben ser los mismos en cada arranque
+class DurableLedger {
+public:
+    DurableLedger(const std::string& journal_path, std::size_t account_count, Money initial_balance = 0,
+                  GroupCommitConfig config = {})
+        : store(account_count, initial_balance), journal(journal_path, config) {
+        // El diario guarda las operaciones en el orden en que se aplicaron, así que al repetirlas en ese orden
+        // cada cargo vuelve a encontrar los mismos fondos que la primera vez
+        journal.replay([this](const JournalRecord& record) {
+            switch (record.operation) {
+            case JournalOperation::Deposit:
+                store.deposit(record.account, record.amount);
+                break;
+            case JournalOperation::Withdraw:
+                store.withdraw(record.account, record.amount);
+                break;
+            case JournalOperation::Transfer:
+                store.transfer(record.account, record.target, record.amount);
+                break;
+            }
+        });
+    }
+
+    std::size_t size() const { return store.size(); }
+    Money balance(AccountId id) const { return store.balance(id); }
+    Money total() const { return store.total(); }
+
+    // Número de operaciones repetidas desde el diario al abrir
+    std::uint64_t replayed_count() const { return journal.recovered_count(); }
+
+    JournalStats journal_stats() const { return journal.stats(); }
+
+    // Como en AccountStore, pero vuelven cuando la operación ya está en disco.
+    // Lanzan std::out_of_range si la cuenta no existe y std::system_error si el disco falla
+    Money deposit(AccountId id, Money amount) {
+        std::uint64_t sequence = 0;
+        Money balance = store.deposit(id, amount, [&] {
+            sequence = journal.append(JournalOperation::Deposit, id, 0, amount);
+        });
+        journal.wait_durable(sequence);
+        return balance;
+    }
+
+    std::optional<Money> withdraw(AccountId id, Money amount) {
+        std::uint64_t sequence = 0;
+        std::optional<Money> remaining = store.withdraw(id, amount, [&] {
+            sequence = journal.append(JournalOperation::Withdraw, id, 0, amount);
+        });
+        if (remaining) {
+            journal.wait_durable(sequence);
+        }
+        return remaining;
+    }
+
+    std::optional<Money> transfer(AccountId from, AccountId to, Money amount) {
+        std::uint64_t sequence = 0;
+        std::optional<Money> remaining = store.transfer(from, to, amount, [&] {
+            sequence = journal.append(JournalOperation::Transfer, from, to, amount);
+        });
+        if (remaining) {
+            journal.wait_durable(sequence);
+        }
+        return remaining;
+    }
+
+private:
+    AccountStore store;
+    Journal journal;
+};
+
+#endif  // DURABLE_LEDGER_H
@@ -0,0 +1,252 @@
+#ifndef JOURNAL_H
+#define JOURNAL_H
+
+#include <algorithm>
+#include <cerrno>
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <functional>
+#include <mutex>
+#include <string>
+#include <system_error>
+#include <thread>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include "bank_account.h"
+
+enum class JournalOperation : std::uint32_t {
+    Deposit = 1,
+    Withdraw = 2,
+    Transfer = 3
+};
+
+// Una operación aplicada, tal como queda en el fichero (32 bytes)
+struct JournalRecord {
+    std::uint64_t sequence;  // Posición en el diario, empezando en 1; 0 = hueco sin escribir
+    JournalOperation operation;
+    std::uint32_t checksum;  // Detecta registros a medio escribir cuando el proceso o la máquina caen
+    std::uint32_t account;
+    std::uint32_t target;    // Solo en transferencias
+    Money amount;
+};
+static_assert(sizeof(JournalRecord) == 32);
+
+// Cuándo se fuerza a disco lo anotado ("group commit")
+struct GroupCommitConfig {
+    // Cuánto puede esperar una operación a que se le unan otras antes de forzar la escritura.
+    // Con 0 se escribe en cuanto hay algo pendiente; aun así se agrupa lo que llegue mientras dura la anterior
+    std::chrono::microseconds max_delay{1000};
+    std::size_t max_batch = 4096;  // Con tantas operaciones pendientes se escribe sin agotar el plazo
+};
+
+// Contadores del diario (copia en un instante dado)
+struct JournalStats {
+    std::uint64_t records = 0;  // Registros anotados desde que se abrió
+    std::uint64_t syncs = 0;    // Llamadas a fdatasync
+
+    double records_per_sync() const { return syncs == 0 ? 0.0 : static_cast<double>(records) / syncs; }
+};
+
+// Diario de solo adición proyectado en memoria con mmap. Se anota después de aplicar cada operación en
+// memoria y antes de confirmarla a quien la pidió: no es un "write-ahead log" en sentido estricto.
+// append() copia el registro en el fichero proyectado y devuelve su número; wait_durable() espera a que ese
+// número esté en disco. Un hilo propio llama a fdatasync para todos los registros pendientes de una vez
+// (en Linux las páginas escritas a través de la proyección son las mismas de la caché del fichero, así que
+// fdatasync también las lleva a disco): con muchas operaciones concurrentes, una sola escritura física
+// confirma cientos, y cada operación espera como mucho max_delay más lo que tarde el disco.
+// El fichero crece duplicando su tamaño cuando se llena; nunca se compacta
+class Journal {
+public:
+    // Abre el diario o lo crea si no existe. Lanza std::system_error si no se puede crear o proyectar
+    Journal(const std::string& path, GroupCommitConfig config = {}) : config(config) {
+        fd = ::open(path.c_str(), O_RDWR | O_CREAT | O_CLOEXEC, 0644);
+        if (fd < 0) {
+            throw std::system_error(errno, std::generic_category(), "No se puede abrir el diario " + path);
+        }
+        struct stat info{};
+        if (::fstat(fd, &info) != 0) {
+            int error = errno;
+            ::close(fd);
+            throw std::system_error(error, std::generic_category(), "No se puede consultar el diario " + path);
+        }
+        std::size_t existing = static_cast<std::size_t>(info.st_size) / sizeof(JournalRecord);
+        try {
+            map(std::max(existing, initial_capacity));
+            recover();
+        } catch (...) {
+            if (records != nullptr) {
+                ::munmap(records, capacity * sizeof(JournalRecord));
+            }
+            ::close(fd);
+            throw;
+        }
+        flusher = std::thread(&Journal::flush_loop, this);
+    }
+
+    Journal(const Journal&) = delete;
+    Journal& operator=(const Journal&) = delete;
+
+    // Escribe lo pendiente antes de cerrar
+    ~Journal() {
+        {
+            std::lock_guard<std::mutex> lock(mtx);
+            stopping = true;
+        }
+        pending_cv.notify_one();
+        flusher.join();
+        ::munmap(records, capacity * sizeof(JournalRecord));
+        ::close(fd);
+    }
+
+    // Registros válidos que había en el fichero al abrirlo
+    std::uint64_t recovered_count() const { return recovered; }
+
+    // Recorre en orden los registros recuperados al abrir el diario
+    void replay(const std::function<void(const JournalRecord&)>& apply) const {
+        for (std::uint64_t i = 0; i < recovered; ++i) {
+            apply(records[i]);
+        }
+    }
+
+    // Anota una operación y devuelve su número de secuencia. No espera al disco.
+    // Lanza std::system_error si el fichero no puede crecer; en ese caso no se anota nada
+    std::uint64_t append(JournalOperation operation, std::uint32_t account, std::uint32_t target, Money amount) {
+        std::lock_guard<std::mutex> lock(mtx);
+        if (appended == capacity) {
+            map(capacity * 2);
+        }
+        JournalRecord record{appended + 1, operation, 0, account, target, amount};
+        record.checksum = checksum_of(record);
+        std::memcpy(static_cast<void*>(&records[appended]), &record, sizeof(record));
+        if (appended == sync_requested) {
+            first_pending_at = std::chrono::steady_clock::now();  // Empieza un grupo nuevo
+            ++appended;
+            pending_cv.notify_one();
+        } else if (++appended - sync_requested == config.max_batch) {
+            pending_cv.notify_one();
+        }
+        return record.sequence;
+    }
+
+    // Espera a que el registro 'sequence' (y todos los anteriores) esté en disco.
+    // Lanza std::system_error si fdatasync falló: lo anotado desde entonces puede no ser durable
+    void wait_durable(std::uint64_t sequence) {
+        std::unique_lock<std::mutex> lock(mtx);
+        durable_cv.wait(lock, [&] { return durable >= sequence || sync_error != 0; });
+        if (durable < sequence) {
+            throw std::system_error(sync_error, std::generic_category(), "No se pudo escribir el diario en disco");
+        }
+    }
+
+    JournalStats stats() const {
+        std::lock_guard<std::mutex> lock(mtx);
+        return {appended - recovered, syncs};
+    }
+
+private:
+    static constexpr std::size_t initial_capacity = 4096;  // Registros; 128 KiB
+
+    static std::uint32_t checksum_of(const JournalRecord& record) {
+        std::uint32_t hash = 2166136261u;  // FNV-1a
+        auto mix = [&hash](std::uint64_t value) {
+            for (int byte = 0; byte < 8; ++byte) {
+                hash = (hash ^ static_cast<std::uint8_t>(value >> (byte * 8))) * 16777619u;
+            }
+        };
+        mix(record.sequence);
+        mix(static_cast<std::uint64_t>(record.operation));
+        mix(record.account);
+        mix(record.target);
+        mix(static_cast<std::uint64_t>(record.amount));
+        return hash;
+    }
+
+    // (Re)proyecta el fichero con 'records_wanted' registros. Se llama con 'mtx' tomado o desde el constructor
+    void map(std::size_t records_wanted) {
+        std::size_t bytes = records_wanted * sizeof(JournalRecord);
+        if (::ftruncate(fd, static_cast<off_t>(bytes)) != 0) {
+            throw std::system_error(errno, std::generic_category(), "No se puede ampliar el diario");
+        }
+        void* memory = records == nullptr
+                           ? ::mmap(nullptr, bytes, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0)
+                           : ::mremap(records, capacity * sizeof(JournalRecord), bytes, MREMAP_MAYMOVE);
+        if (memory == MAP_FAILED) {
+            throw std::system_error(errno, std::generic_category(), "No se puede proyectar el diario");
+        }
+        records = static_cast<JournalRecord*>(memory);
+        capacity = records_wanted;
+    }
+
+    // Los registros válidos forman un prefijo: se para en el primero sin escribir, roto o fuera de secuencia.
+    // Lo que haya detrás no llegó a confirmarse y se borra entero, hasta el final del fichero: tras un hueco
+    // puede haber registros antiguos con la secuencia correcta que, al rellenar el hueco con anotaciones
+    // nuevas, volverían a formar parte del prefijo. Recortar el fichero y volver a ampliarlo deja ceros
+    // sin tener que recorrerlo
+    void recover() {
+        while (recovered < capacity && records[recovered].sequence == recovered + 1 &&
+               records[recovered].checksum == checksum_of(records[recovered])) {
+            ++recovered;
+        }
+        if (recovered < capacity) {
+            if (::ftruncate(fd, static_cast<off_t>(recovered * sizeof(JournalRecord))) != 0 ||
+                ::ftruncate(fd, static_cast<off_t>(capacity * sizeof(JournalRecord))) != 0 || ::fdatasync(fd) != 0) {
+                throw std::system_error(errno, std::generic_category(), "No se puede limpiar el diario");
+            }
+        }
+        appended = durable = sync_requested = recovered;
+    }
+
+    void flush_loop() {
+        std::unique_lock<std::mutex> lock(mtx);
+        while (true) {
+            pending_cv.wait(lock, [&] { return stopping || appended > sync_requested; });
+            if (appended == sync_requested) {
+                return;  // Parada sin nada pendiente
+            }
+            // Se deja que el grupo crezca hasta agotar el plazo del primero o llenar el lote
+            pending_cv.wait_until(lock, first_pending_at + config.max_delay,
+                                  [&] { return stopping || appended - sync_requested >= config.max_batch; });
+            std::uint64_t target = appended;
+            sync_requested = target;
+            lock.unlock();
+            int result = ::fdatasync(fd);  // Sin el mutex: las operaciones siguen anotándose mientras tanto
+            int error = result == 0 ? 0 : errno;
+            lock.lock();
+            ++syncs;
+            if (error != 0) {
+                sync_error = error;  // Permanente: un fdatasync posterior que salga bien no garantiza lo anterior
+            }
+            if (sync_error == 0) {
+                durable = target;
+            }
+            durable_cv.notify_all();
+        }
+    }
+
+    GroupCommitConfig config;
+    int fd = -1;
+    JournalRecord* records = nullptr;
+    std::size_t capacity = 0;
+    std::uint64_t recovered = 0;
+
+    mutable std::mutex mtx;
+    std::condition_variable pending_cv;  // Avisa al hilo de escritura
+    std::condition_variable durable_cv;  // Avisa a quienes esperan en wait_durable
+    std::uint64_t appended = 0;          // Registros anotados (el siguiente número es appended + 1)
+    std::uint64_t sync_requested = 0;    // Hasta dónde cubre la última escritura lanzada
+    std::uint64_t durable = 0;           // Hasta dónde está en disco
+    std::chrono::steady_clock::time_point first_pending_at;
+    std::uint64_t syncs = 0;
+    int sync_error = 0;
+    bool stopping = false;
+    std::thread flusher;
+};
+
+#endif  // JOURNAL_H
@@ -0,0 +1,188 @@
+#ifndef LOCK_PROFILER_H
+#define LOCK_PROFILER_H
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <iomanip>
+#include <iostream>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "../comun/latency_histogram.h"
+
+// Medidas de un cerrojo (copia en un instante dado)
+struct LockProfile {
+    std::string name;
+    std::uint64_t acquisitions = 0;
+    std::uint64_t failed_try_locks = 0;  // try_lock que encontraron el cerrojo tomado (no son adquisiciones)
+    // Intentos que encontraron el cerrojo tomado: adquisiciones que tuvieron que esperar más try_lock fallidos.
+    // std::scoped_lock con varios cerrojos usa try_lock y, si falla, suelta lo que tenía y vuelve a empezar:
+    // sin contar los fallos, esa competencia parecería un puñado de adquisiciones sin espera
+    std::uint64_t contended = 0;
+    HistogramSnapshot wait;       // Tiempo hasta conseguir el cerrojo (0 si estaba libre)
+    HistogramSnapshot hold;       // Tiempo con el cerrojo tomado
+};
+
+#ifdef LOCK_PROFILING
+class ProfiledMutex;
+
+// Registro global de los ProfiledMutex vivos. Solo se toca al crear y destruir cerrojos y al pedir un informe
+class LockRegistry {
+public:
+    static LockRegistry& instance() {
+        static LockRegistry registry;
+        return registry;
+    }
+
+    void add(const ProfiledMutex* lock) {
+        std::lock_guard<std::mutex> guard(mtx);
+        locks.push_back(lock);
+    }
+
+    void remove(const ProfiledMutex* lock) {
+        std::lock_guard<std::mutex> guard(mtx);
+        locks.erase(std::remove(locks.begin(), locks.end(), lock), locks.end());
+    }
+
+    std::vector<LockProfile> profiles() const;
+
+private:
+    mutable std::mutex mtx;
+    std::vector<const ProfiledMutex*> locks;
+};
+
+// Mutex que mide cuántas veces se adquiere, cuánto se espera para conseguirlo y cuánto se retiene.
+// Se usa igual que std::mutex (con lock_guard, unique_lock o scoped_lock). Todo se anota con el cerrojo ya
+// tomado, así que las anotaciones están serializadas por el propio cerrojo y no necesitan operaciones
+// atómicas de lectura-escritura. Si el cerrojo está libre, adquirirlo y soltarlo solo añade un try_lock y
+// dos lecturas del reloj; el tiempo de espera solo se mide cuando hay que esperar. Un try_lock fallido no
+// tiene el cerrojo, así que se cuenta con un incremento atómico.
+// Cada instancia ocupa unos 4 KiB (dos histogramas de 256 cubos de 8 bytes): con miles de cerrojos conviene
+// perfilar solo en las compilaciones de diagnóstico
+class ProfiledMutex {
+public:
+    explicit ProfiledMutex(std::string_view name = "mutex") : lock_name(name) { LockRegistry::instance().add(this); }
+
+    ProfiledMutex(const ProfiledMutex&) = delete;
+    ProfiledMutex& operator=(const ProfiledMutex&) = delete;
+
+    ~ProfiledMutex() { LockRegistry::instance().remove(this); }
+
+    // Nombre con el que aparece en los informes. Cambiarlo con el cerrojo en uso no es seguro
+    void set_name(std::string_view name) { lock_name = name; }
+
+    void lock() {
+        if (mtx.try_lock()) {
+            acquired();
+            return;
+        }
+        auto start = std::chrono::steady_clock::now();
+        mtx.lock();
+        acquired();
+        contended_wait.record_serialized(acquired_at - start);
+    }
+
+    bool try_lock() {
+        if (!mtx.try_lock()) {
+            failed_try_locks.fetch_add(1, std::memory_order_relaxed);
+            return false;
+        }
+        acquired();
+        return true;
+    }
+
+    void unlock() {
+        hold.record_serialized(std::chrono::steady_clock::now() - acquired_at);
+        mtx.unlock();
+    }
+
+    LockProfile profile() const {
+        LockProfile result{lock_name, acquisitions.load(std::memory_order_relaxed),
+                           failed_try_locks.load(std::memory_order_relaxed), 0, contended_wait.snapshot(),
+                           hold.snapshot()};
+        // Las adquisiciones sin espera cuentan como esperas de 0 ns
+        std::uint64_t waited = result.wait.count;
+        std::uint64_t immediate = result.acquisitions > waited ? result.acquisitions - waited : 0;
+        result.wait.buckets[0] += immediate;
+        result.wait.count += immediate;
+        result.contended = waited + result.failed_try_locks;
+        return result;
+    }
+
+private:
+    void acquired() {
+        acquisitions.store(acquisitions.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+        acquired_at = std::chrono::steady_clock::now();
+    }
+
+    std::mutex mtx;
+    std::string lock_name;
+    std::chrono::steady_clock::time_point acquired_at;  // Solo la toca quien tiene el cerrojo
+    std::atomic<std::uint64_t> acquisitions{0};
+    std::atomic<std::uint64_t> failed_try_locks{0};  // Se incrementa sin el cerrojo
+    LatencyHistogram contended_wait;  // Solo las adquisiciones que tuvieron que esperar
+    LatencyHistogram hold;
+};
+
+inline std::vector<LockProfile> LockRegistry::profiles() const {
+    std::lock_guard<std::mutex> guard(mtx);
+    std::vector<LockProfile> result;
+    result.reserve(locks.size());
+    for (const ProfiledMutex* lock : locks) {
+        result.push_back(lock->profile());
+    }
+    return result;
+}
+
+constexpr bool lock_profiling_enabled = true;
+
+// Medidas de todos los ProfiledMutex vivos
+inline std::vector<LockProfile> lock_profiles() { return LockRegistry::instance().profiles(); }
+#else
+// Sin LOCK_PROFILING, ProfiledMutex es un std::mutex: mismo tamaño, mismo coste y ningún registro.
+// El nombre se descarta
+class ProfiledMutex : public std::mutex {
+public:
+    explicit ProfiledMutex(std::string_view = {}) {}
+
+    void set_name(std::string_view) {}
+};
+
+constexpr bool lock_profiling_enabled = false;
+
+inline std::vector<LockProfile> lock_profiles() { return {}; }
+#endif
+
+// Imprime los 'top' cerrojos con más tiempo total de espera: los que más serializan a los hilos
+inline void print_hottest_locks(std::ostream& out, std::size_t top) {
+    if (!lock_profiling_enabled) {
+        out << "Perfilado de cerrojos desactivado (compilar con -DLOCK_PROFILING)" << std::endl;
+        return;
+    }
+    std::vector<LockProfile> profiles = lock_profiles();
+    std::sort(profiles.begin(), profiles.end(),
+              [](const LockProfile& a, const LockProfile& b) { return a.wait.sum_ns > b.wait.sum_ns; });
+    profiles.resize(std::min(top, profiles.size()));
+
+    auto us = [](std::chrono::nanoseconds value) { return value.count() / 1e3; };
+    for (const LockProfile& profile : profiles) {
+        std::uint64_t attempts = profile.acquisitions + profile.failed_try_locks;
+        double contended_percent = attempts == 0 ? 0.0 : 100.0 * profile.contended / attempts;
+        out << std::left << std::setw(20) << profile.name << std::right << std::fixed << std::setprecision(1)
+            << " adquisiciones=" << profile.acquisitions
+            << " try_lock fallidos=" << profile.failed_try_locks
+            << " esperas=" << contended_percent << "%"
+            << " espera total=" << profile.wait.sum_ns / 1e6 << "ms"
+            << std::setprecision(2)
+            << " espera p99=" << us(profile.wait.percentile(0.99)) << "us"
+            << " retención media=" << us(profile.hold.mean()) << "us"
+            << " p99=" << us(profile.hold.percentile(0.99)) << "us" << std::endl;
+    }
+}
+
+#endif  // LOCK_PROFILER_H
@@ -1,77 +1,31 @@
 #include <iostream>
 #include <thread>
-#include <mutex>
-#include <algorithm>  // Para std::min y std::max
+#include <functional>
 
-class BankAccount {
-private:
-    double balance;
-    std::mutex mtx;  // Mutex para proteger el acceso al balance
-
-public:
-    BankAccount(double initial_balance) : balance(initial_balance) {}
-
-    // Método para obtener el balance (lectura sincrónica)
-    double getBalance() {
-        std::lock_guard<std::mutex> lock(mtx);  // Sincronización para lectura
-        return balance;
-    }
-
-    // Método para depositar dinero
-    void deposit(double amount) {
-        std::lock_guard<std::mutex> lock(mtx);  // Sincronización
-        std::cout << "Depositando " << amount << "...\n";
-        balance += amount;
-        std::cout << "Nuevo balance tras el deposito: " << balance << "\n";
-    }
-
-    // Método para retirar dinero
-    void withdraw(double amount) {
-        std::lock_guard<std::mutex> lock(mtx);  // Sincronización
-        if (balance >= amount) {
-            std::cout << "Retirando " << amount << "...\n";
-            balance -= amount;
-            std::cout << "Nuevo balance tras la retirada: " << balance << "\n";
-        } else {
-            std::cout << "Fondos insuficientes para retirar " << amount << "!\n";
-        }
-    }
-
-    // Método para transferir dinero entre dos cuentas, evitando el interbloqueo
-    void transfer(BankAccount& to, double amount) {
-        BankAccount* first = this;
-        BankAccount* second = &to;
-
-        // Ordenar las cuentas para evitar interbloqueos
-        if (this > &to) {
-            std::swap(first, second);
-        }
-
-        // Bloqueo en el mismo orden siempre
-        std::scoped_lock lock(first->mtx, second->mtx);
-        
-        if (balance >= amount) {
-            std::cout << "Transferencia de " << amount << " de esta cuenta a otra cuenta...\n";
-            balance -= amount;
-            to.balance += amount;
-            std::cout << "Transferencia completada. Nuevo balance: " << balance << "\n";
-        } else {
-            std::cout << "Fondos insuficientes para transferir " << amount << "!\n";
-        }
-    }
-};
+#include "bank_account.h"
 
 void threadFunction1(BankAccount& account) {
-    account.deposit(100);  // Hilo 1: realiza un depósito
+    // Hilo 1: realiza un depósito
+    Money amount = from_units(100);
+    Money balance = account.deposit(amount);
+    std::cout << "Depositado " << format_money(amount) << ". Nuevo balance tras el deposito: "
+              << format_money(balance) << "\n";
 }
 
 void threadFunction2(BankAccount& account1, BankAccount& account2) {
-    account1.transfer(account2, 50);  // Hilo 2: realiza una transferencia
+    // Hilo 2: realiza una transferencia
+    Money amount = from_units(50);
+    if (std::optional<Money> balance = account1.transfer(account2, amount)) {
+        std::cout << "Transferencia de " << format_money(amount) << " completada. Nuevo balance: "
+                  << format_money(*balance) << "\n";
+    } else {
+        std::cout << "Fondos insuficientes para transferir " << format_money(amount) << "!\n";
+    }
 }
 
 int main() {
-    BankAccount account1(200);  // Primera cuenta con $200
-    BankAccount account2(100);  // Segunda cuenta con $100
+    BankAccount account1(from_units(200), "cuenta 1");  // Primera cuenta con $200
+    BankAccount account2(from_units(100), "cuenta 2");  // Segunda cuenta con $100
 
     std::thread t1(threadFunction1, std::ref(account1));  // Hilo para hacer un depósito
     std::thread t2(threadFunction2, std::ref(account1), std::ref(account2));  // Hilo para transferir dinero
@@ -79,5 +33,8 @@ int main() {
     t1.join();
     t2.join();
 
+    auto [balance1, balance2] = balances(account1, account2);  // Lectura conjunta: sin transferencias a medias
+    std::cout << "Balances finales: " << format_money(balance1) << " y " << format_money(balance2) << "\n";
+    print_hottest_locks(std::cout, 2);  // Con -DLOCK_PROFILING: esperas en los cerrojos de las transferencias
     return 0;
 }
@@ -0,0 +1,37 @@
+#ifndef ZIPF_GENERATOR_H
+#define ZIPF_GENERATOR_H
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <random>
+#include <vector>
+
+#include "account_store.h"
+
+// Genera números de cuenta con distribución de Zipf: la cuenta de rango k sale con probabilidad
+// proporcional a 1 / (k + 1)^s. Con s = 0 todas son igual de probables
+class ZipfGenerator {
+public:
+    ZipfGenerator(std::size_t count, double exponent) : cumulative(count) {
+        double sum = 0.0;
+        for (std::size_t k = 0; k < count; ++k) {
+            sum += 1.0 / std::pow(static_cast<double>(k + 1), exponent);
+            cumulative[k] = sum;
+        }
+        for (double& value : cumulative) {
+            value /= sum;
+        }
+    }
+
+    AccountId operator()(std::mt19937_64& random) {
+        double u = std::uniform_real_distribution<double>(0.0, 1.0)(random);
+        auto it = std::lower_bound(cumulative.begin(), cumulative.end(), u);
+        return static_cast<AccountId>(std::min<std::size_t>(it - cumulative.begin(), cumulative.size() - 1));
+    }
+
+private:
+    std::vector<double> cumulative;
+};
+
+#endif  // ZIPF_GENERATOR_H
@@ -0,0 +1,123 @@
+// Benchmark: DataProcessor::processData sobre 10^7 y 10^8 elementos con 1 a 16 hilos en el WorkerPool,
+// y lecturas concurrentes mientras se publican versiones nuevas
+// Compilar: g++ -std=c++20 -O2 -pthread benchmark_data_processor.cpp -o benchmark_data_processor
+#include <iostream>
+#include <iomanip>
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <random>
+#include <thread>
+#include <vector>
+
+#include "data_processor.h"
+#include "worker_pool.h"
+
+// Mejor tiempo de 'repetitions' procesamientos, en milisegundos. Comprueba la suma y algunos elementos
+double best_time_ms(DataProcessor& processor, int repetitions, bool& correct) {
+    const auto n = static_cast<std::int64_t>(processor.size());
+    double best = 0.0;
+    for (int r = 0; r < repetitions; ++r) {
+        ProcessingResult result = processor.processData();
+        std::chrono::duration<double, std::milli> elapsed = result.elapsed;
+        best = r == 0 ? elapsed.count() : std::min(best, elapsed.count());
+        correct = correct && result.sum == n * (n - 1) && processor.getData(0) == 0 &&
+                  processor.getData(processor.size() - 1) == static_cast<int>(2 * (n - 1));
+    }
+    return best;
+}
+
+// Lectores que leen elementos al azar mientras un hilo publica versiones sin parar. Devuelve millones de
+// lecturas por segundo; 'per_snapshot' es cuántas lecturas hace cada lector con cada versión que pide
+// (1 = getData en cada lectura). Anota la mediana y el percentil 99 del tiempo de publicación en microsegundos
+double run_readers(unsigned reader_count, int per_snapshot, double& publish_p50_us, double& publish_p99_us,
+                   bool& correct) {
+    const std::size_t size = 1'000'000;
+    WorkerPool pool(1);
+    DataProcessor processor(size, real_time_clock(), pool);
+    processor.processData();  // Antes de leer: a partir de aquí todas las versiones valen 2 * i
+    std::atomic<bool> stop{false};
+    std::atomic<std::uint64_t> reads{0};
+    std::atomic<bool> consistent{true};
+    std::vector<std::thread> readers;
+    for (unsigned r = 0; r < reader_count; ++r) {
+        readers.emplace_back([&, r] {
+            std::mt19937 random(r);
+            std::uniform_int_distribution<std::size_t> index(0, size - 1);
+            std::uint64_t local_reads = 0;
+            bool local_consistent = true;  // Local: una escritura compartida por lectura estorbaría a los demás
+            while (!stop.load(std::memory_order_relaxed)) {
+                if (per_snapshot == 1) {
+                    std::size_t i = index(random);
+                    local_consistent = local_consistent && processor.getData(i) == static_cast<int>(2 * i);
+                    ++local_reads;
+                    continue;
+                }
+                std::shared_ptr<const DataSnapshot> snapshot = processor.snapshot();
+                for (int k = 0; k < per_snapshot; ++k) {
+                    std::size_t i = index(random);
+                    local_consistent = local_consistent && snapshot->values[i] == static_cast<int>(2 * i);
+                }
+                local_reads += per_snapshot;
+            }
+            reads.fetch_add(local_reads);
+            if (!local_consistent) {
+                consistent = false;
+            }
+        });
+    }
+    auto start = std::chrono::steady_clock::now();
+    std::vector<double> publish_us;
+    while (std::chrono::steady_clock::now() - start < std::chrono::milliseconds(500)) {
+        std::chrono::duration<double, std::micro> publish = processor.processData().publish;
+        publish_us.push_back(publish.count());
+    }
+    stop = true;
+    for (auto& reader : readers) {
+        reader.join();
+    }
+    std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+    // Con más hilos que núcleos, alguna publicación incluye una expulsión del planificador: de ahí la mediana
+    std::sort(publish_us.begin(), publish_us.end());
+    publish_p50_us = publish_us[publish_us.size() / 2];
+    publish_p99_us = publish_us[publish_us.size() * 99 / 100];
+    if (!consistent) {
+        std::cerr << "Un lector vio un valor incorrecto" << std::endl;
+        correct = false;
+    }
+    return reads.load() / elapsed.count() / 1e6;
+}
+
+int main() {
+    std::cout << std::thread::hardware_concurrency() << " núcleo(s), trozos de " << DataProcessor::chunk_size
+              << " elementos\n";
+    std::cout << std::setw(12) << "elementos" << std::setw(8) << "hilos" << std::setw(14) << "tiempo (ms)"
+              << std::setw(14) << "aceleración" << "\n";
+    bool correct = true;
+    for (std::size_t size : {std::size_t{10'000'000}, std::size_t{100'000'000}}) {
+        double single = 0.0;
+        for (unsigned threads : {1u, 2u, 4u, 8u, 16u}) {
+            WorkerPool pool(threads);
+            DataProcessor processor(size, real_time_clock(), pool);
+            double time = best_time_ms(processor, 5, correct);
+            if (threads == 1) {
+                single = time;
+            }
+            std::cout << std::setw(12) << size << std::setw(8) << threads << std::fixed << std::setprecision(2)
+                      << std::setw(14) << time << std::setw(14) << single / time << "\n";
+        }
+    }
+
+    // Los lectores no toman ningún mutex y publicar es cambiar un puntero, tenga la versión el tamaño que tenga
+    std::cout << "\n" << std::setw(10) << "lectores" << std::setw(24) << "getData (M lect./s)" << std::setw(30)
+              << "versión x1000 (M lect./s)" << std::setw(30) << "publicación p50/p99" << "\n";
+    for (unsigned readers : {1u, 2u, 4u, 8u}) {
+        double p50_us = 0.0, p99_us = 0.0, ignored_p50 = 0.0, ignored_p99 = 0.0;
+        double single_reads = run_readers(readers, 1, p50_us, p99_us, correct);
+        double snapshot_reads = run_readers(readers, 1000, ignored_p50, ignored_p99, correct);
+        std::cout << std::setw(10) << readers << std::fixed << std::setprecision(2) << std::setw(24) << single_reads
+                  << std::setw(29) << snapshot_reads << std::setw(19) << p50_us << "/" << p99_us << " us\n";
+    }
+    std::cout << "Resultados correctos: " << (correct ? "sí" : "NO") << "\n";
+    return correct ? 0 : 1;
+}
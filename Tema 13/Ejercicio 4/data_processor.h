@@ -0,0 +1,120 @@
+#ifndef DATA_PROCESSOR_H
+#define DATA_PROCESSOR_H
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+#include "../comun/clock.h"
+#include "worker_pool.h"
+
+// Resultado de un procesamiento: cuánto tardó, cuánto de eso fue publicarlo y la suma de todos los valores
+struct ProcessingResult {
+    Clock::duration elapsed{};
+    Clock::duration publish{};
+    std::int64_t sum = 0;
+};
+
+// Versión publicada de los datos. No cambia nunca después de publicarse: quien la tenga puede leerla
+// sin sincronización y el tiempo que quiera, aunque entretanto se publiquen otras
+struct DataSnapshot {
+    std::vector<int> values;
+    std::int64_t sum = 0;
+};
+
+class DataProcessor {
+public:
+    // Elementos por trozo: 64 KiB de enteros, que caben en la caché L2 de un núcleo
+    static constexpr std::size_t chunk_size = 16 * 1024;
+
+    // Constructor que inicializa los datos
+    DataProcessor(std::size_t size, Clock& clock = real_time_clock(), WorkerPool& pool = default_worker_pool())
+        : current(std::make_shared<DataSnapshot>(DataSnapshot{std::vector<int>(size, 0), 0})),
+          data_size(size),
+          clock(clock),
+          pool(pool) {}
+
+    // Calcula todos los valores en paralelo, por trozos, en una versión nueva. Cada hilo acumula su suma
+    // parcial en su propia línea de caché; al final se suman las parciales y la versión se publica cambiando
+    // un puntero (publicación al estilo RCU): no hay mutex para los lectores y publicar cuesta lo mismo
+    // con diez elementos que con diez millones. La versión anterior se libera cuando la suelte el último
+    // lector que la tenga; si no la tiene nadie, su búfer se reutiliza para la siguiente.
+    // Si varios hilos procesan a la vez, lo hacen de uno en uno
+    ProcessingResult processData() {
+        std::lock_guard<std::mutex> process_lock(process_mtx);
+        auto start = clock.now();
+
+        std::shared_ptr<DataSnapshot> next = std::move(spare);
+        if (!next) {
+            next = std::make_shared<DataSnapshot>(DataSnapshot{std::vector<int>(data_size), 0});
+        }
+        std::vector<PartialSum> partial_sums(pool.size());
+        pool.parallel_for(data_size, chunk_size, [&](std::size_t begin, std::size_t end, unsigned worker) {
+            std::int64_t sum = 0;
+            for (std::size_t i = begin; i < end; ++i) {
+                int value = compute(i);
+                next->values[i] = value;
+                sum += value;
+            }
+            partial_sums[worker].value += sum;
+        });
+        next->sum = 0;
+        for (const PartialSum& partial : partial_sums) {
+            next->sum += partial.value;
+        }
+        std::int64_t sum = next->sum;
+
+        auto publish_start = clock.now();
+        std::shared_ptr<const DataSnapshot> previous = current.exchange(std::move(next));  // Publicación única
+        auto publish_end = clock.now();
+
+        // Nadie más la tiene y ya no se puede obtener desde 'current': se puede volver a escribir
+        if (previous.use_count() == 1) {
+            // use_count() lee el contador con memory_order_relaxed: esta barrera ordena las escrituras que
+            // siguen después de las lecturas que el último lector hizo antes de soltar su copia
+            std::atomic_thread_fence(std::memory_order_acquire);
+            spare = std::const_pointer_cast<DataSnapshot>(std::move(previous));
+        }
+        return {publish_end - start, publish_end - publish_start, sum};
+    }
+
+    // Versión publicada más reciente. Para leer muchos elementos conviene pedirla una vez y leer de ella:
+    // todos los valores serán de la misma versión
+    std::shared_ptr<const DataSnapshot> snapshot() const { return current.load(std::memory_order_acquire); }
+
+    // Lee un elemento de la versión publicada; -1 si el índice está fuera de rango
+    int getData(std::size_t index) const {
+        std::shared_ptr<const DataSnapshot> data = snapshot();
+        if (index < data->values.size()) {
+            return data->values[index];
+        }
+        return -1;
+    }
+
+    // Suma de los datos publicados
+    std::int64_t getSum() const { return snapshot()->sum; }
+
+    std::size_t size() const { return data_size; }
+
+private:
+    struct alignas(64) PartialSum {
+        std::int64_t value = 0;
+    };
+
+    // Valor del elemento 'i'
+    static int compute(std::size_t i) { return static_cast<int>(i * 2); }
+
+    std::atomic<std::shared_ptr<const DataSnapshot>> current;  // Versión publicada
+    std::size_t data_size;
+    std::shared_ptr<DataSnapshot> spare;  // Versión antigua que nadie lee; solo la usa processData
+    std::mutex process_mtx;               // Un procesamiento cada vez: comparten 'spare'
+    Clock& clock;
+    WorkerPool& pool;
+};
+
+#endif  // DATA_PROCESSOR_H
@@ -1,61 +1,26 @@
 #include <iostream>
 #include <thread>
-#include <mutex>
-#include <vector>
 #include <chrono>
 
-class DataProcessor {
-private:
-    std::vector<int> data;
-    std::mutex mtx;
-
-public:
-    // Constructor que inicializa los datos
-    DataProcessor(int size) {
-        data.resize(size, 0);
-    }
-
-    // Método que procesa los datos, reduciendo la sincronización
-    void processData() {
-        std::vector<int> localData(data.size());  // Procesamiento en una copia local
-
-        // Simula un procesamiento lento de datos
-        for (int i = 0; i < localData.size(); ++i) {
-            std::this_thread::sleep_for(std::chrono::milliseconds(10));  // Simula trabajo pesado
-            localData[i] = i * 2;
-        }
-
-        // Bloqueo reducido solo para la actualización del recurso compartido
-        {
-            std::lock_guard<std::mutex> lock(mtx);
-            data = localData;  // Actualización crítica
-        }
-
-        std::cout << "Datos procesados.\n";
-    }
-
-    // Método para leer los datos de forma segura
-    int getData(int index) {
-        std::lock_guard<std::mutex> lock(mtx);  // Sincronización para lectura
-        if (index >= 0 && index < data.size()) {
-            return data[index];
-        }
-        return -1;
-    }
-};
+#include "../comun/clock.h"
+#include "data_processor.h"
 
 void threadFunction(DataProcessor& processor) {
-    processor.processData();  // Cada hilo intentará procesar los datos
+    ProcessingResult result = processor.processData();  // Cada hilo intentará procesar los datos
+    std::chrono::duration<double, std::milli> elapsed = result.elapsed;
+    std::cout << "Datos procesados en " << elapsed.count() << " ms, suma = " << result.sum << "\n";
 }
 
 int main() {
-    DataProcessor processor(10);  // Crear un DataProcessor con 10 elementos
+    Clock& clock = real_time_clock();  // Solo sirve para medir cuánto tarda cada procesado
+    DataProcessor processor(10'000'000, clock);  // Crear un DataProcessor con 10 millones de elementos
 
-    std::thread t1(threadFunction, std::ref(processor));  // Hilo 1
-    std::thread t2(threadFunction, std::ref(processor));  // Hilo 2
+    std::thread t1 = start_clocked_thread(clock, threadFunction, std::ref(processor));  // Hilo 1
+    std::thread t2 = start_clocked_thread(clock, threadFunction, std::ref(processor));  // Hilo 2
 
-    t1.join();
-    t2.join();
+    join_clocked_thread(clock, t1);
+    join_clocked_thread(clock, t2);
 
+    std::cout << "Último elemento: " << processor.getData(processor.size() - 1) << "\n";
     return 0;
 }
@@ -0,0 +1,138 @@
+#ifndef WORKER_POOL_H
+#define WORKER_POOL_H
+
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <exception>
+#include <mutex>
+#include <thread>
+#include <type_traits>
+#include <vector>
+
+// Conjunto de hilos que se crean una vez y se reutilizan para repartir bucles entre núcleos.
+// parallel_for divide un rango en trozos y cada hilo va tomando el siguiente trozo libre, así que un hilo
+// más lento (o un núcleo ocupado por otro proceso) no retrasa a los demás. El hilo que llama trabaja también.
+// Los trabajos se ejecutan de uno en uno: si dos hilos llaman a parallel_for a la vez, el segundo espera
+class WorkerPool {
+public:
+    // 'thread_count' cuenta también al hilo que llama a parallel_for
+    explicit WorkerPool(unsigned thread_count = std::thread::hardware_concurrency())
+        : worker_count(std::max(thread_count, 1u)) {
+        for (unsigned i = 1; i < worker_count; ++i) {
+            threads.emplace_back(&WorkerPool::worker_loop, this, i);
+        }
+    }
+
+    WorkerPool(const WorkerPool&) = delete;
+    WorkerPool& operator=(const WorkerPool&) = delete;
+
+    ~WorkerPool() {
+        {
+            std::lock_guard<std::mutex> lock(mtx);
+            stopping = true;
+        }
+        start_cv.notify_all();
+        for (auto& thread : threads) {
+            thread.join();
+        }
+    }
+
+    unsigned size() const { return worker_count; }
+
+    // Llama a function(begin, end, worker) para cada trozo [begin, end) de [0, count), de 'chunk_size' elementos
+    // como mucho. 'worker' va de 0 a size() - 1 y es distinto para cada hilo que trabaja a la vez: sirve para
+    // acumular resultados parciales sin compartirlos. Vuelve cuando todos los trozos están hechos; si alguna
+    // llamada lanza una excepción, no se empiezan más trozos y se relanza aquí la primera
+    template <typename Function>
+    void parallel_for(std::size_t count, std::size_t chunk_size, Function&& function) {
+        using Callable = std::remove_reference_t<Function>;
+        std::lock_guard<std::mutex> submit_lock(submit_mtx);
+        {
+            std::lock_guard<std::mutex> lock(mtx);
+            job = {&function, [](void* context, std::size_t begin, std::size_t end, unsigned worker) {
+                       (*static_cast<Callable*>(context))(begin, end, worker);
+                   }, count, std::max<std::size_t>(chunk_size, 1)};
+            next_chunk.store(0, std::memory_order_relaxed);
+            error = nullptr;
+            busy = worker_count - 1;
+            ++generation;
+        }
+        start_cv.notify_all();
+        run_chunks(0);
+        std::unique_lock<std::mutex> lock(mtx);
+        done_cv.wait(lock, [&] { return busy == 0; });
+        if (error) {
+            std::rethrow_exception(error);
+        }
+    }
+
+private:
+    struct Job {
+        void* context = nullptr;
+        void (*invoke)(void*, std::size_t, std::size_t, unsigned) = nullptr;
+        std::size_t count = 0;
+        std::size_t chunk_size = 1;
+    };
+
+    void worker_loop(unsigned worker) {
+        std::uint64_t seen = 0;
+        std::unique_lock<std::mutex> lock(mtx);
+        while (true) {
+            start_cv.wait(lock, [&] { return stopping || generation != seen; });
+            if (stopping) {
+                return;
+            }
+            seen = generation;
+            lock.unlock();
+            run_chunks(worker);
+            lock.lock();
+            if (--busy == 0) {
+                done_cv.notify_one();
+            }
+        }
+    }
+
+    // 'job' no cambia mientras haya hilos trabajando en él: parallel_for espera a que terminen todos
+    void run_chunks(unsigned worker) {
+        while (true) {
+            std::size_t begin = next_chunk.fetch_add(job.chunk_size, std::memory_order_relaxed);
+            if (begin >= job.count) {
+                return;
+            }
+            try {
+                job.invoke(job.context, begin, std::min(begin + job.chunk_size, job.count), worker);
+            } catch (...) {
+                next_chunk.store(job.count, std::memory_order_relaxed);  // Nadie empieza trozos nuevos
+                std::lock_guard<std::mutex> lock(mtx);
+                if (!error) {
+                    error = std::current_exception();
+                }
+            }
+        }
+    }
+
+    unsigned worker_count;
+    std::vector<std::thread> threads;
+
+    std::mutex submit_mtx;  // Un trabajo cada vez
+    std::mutex mtx;
+    std::condition_variable start_cv;
+    std::condition_variable done_cv;
+    Job job;
+    std::atomic<std::size_t> next_chunk{0};
+    std::uint64_t generation = 0;  // Cambia con cada trabajo nuevo
+    unsigned busy = 0;             // Hilos (sin contar al que llama) que aún no han terminado el trabajo actual
+    std::exception_ptr error;
+    bool stopping = false;
+};
+
+// Conjunto compartido con un hilo por núcleo que se usa por defecto
+inline WorkerPool& default_worker_pool() {
+    static WorkerPool pool;
+    return pool;
+}
+
+#endif  // WORKER_POOL_H
@@ -0,0 +1,222 @@
+#ifndef CLOCK_H
+#define CLOCK_H
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#ifdef __linux__
+#include <cerrno>
+#include <ctime>
+#endif
+
+// Reloj inyectable: las clases que esperan o miden tiempo lo reciben en lugar de llamar
+// directamente a std::this_thread::sleep_for, así se pueden ejecutar en tiempo real o en tiempo simulado
+class Clock {
+public:
+    using duration = std::chrono::steady_clock::duration;
+    using time_point = std::chrono::steady_clock::time_point;
+
+    virtual ~Clock() = default;
+
+    virtual time_point now() const = 0;
+
+    virtual void sleep_until(time_point when) = 0;
+
+    void sleep_for(duration length) { sleep_until(now() + length); }
+
+    // Espera hasta que 'ready' devuelva true o se alcance 'deadline'. Devuelve el último valor de 'ready'.
+    // Quien haga cierta la condición debe llamar después a notify_waiters()
+    virtual bool wait_until(time_point deadline, const std::function<bool()>& ready) = 0;
+
+    virtual void notify_waiters() = 0;
+
+    // Un reloj simulado necesita saber qué hilos lo usan para decidir cuándo avanzar el tiempo
+    virtual bool is_simulated() const { return false; }
+    virtual void add_participant() {}
+    virtual void remove_participant() {}
+
+    // Marca al hilo como parado en una espera ajena al reloj (por ejemplo, un join)
+    virtual void begin_external_wait() {}
+    virtual void end_external_wait() {}
+};
+
+// Reloj de tiempo real basado en std::chrono::steady_clock
+class RealClock : public Clock {
+public:
+    time_point now() const override { return std::chrono::steady_clock::now(); }
+
+    // Espera hasta un instante absoluto. En Linux, steady_clock es CLOCK_MONOTONIC y se usa clock_nanosleep
+    // con TIMER_ABSTIME: un despertar tardío no desplaza los plazos siguientes, a diferencia de una espera relativa
+    void sleep_until(time_point when) override {
+#ifdef __linux__
+        auto since_epoch = std::chrono::duration_cast<std::chrono::nanoseconds>(when.time_since_epoch()).count();
+        timespec deadline{};
+        deadline.tv_sec = static_cast<std::time_t>(since_epoch / 1'000'000'000);
+        deadline.tv_nsec = static_cast<long>(since_epoch % 1'000'000'000);
+        while (clock_nanosleep(CLOCK_MONOTONIC, TIMER_ABSTIME, &deadline, nullptr) == EINTR) {
+        }
+#else
+        std::this_thread::sleep_until(when);
+#endif
+    }
+
+    bool wait_until(time_point deadline, const std::function<bool()>& ready) override {
+        std::unique_lock<std::mutex> lock(mtx);
+        if (deadline == time_point::max()) {
+            cv.wait(lock, ready);
+            return true;
+        }
+        return cv.wait_until(lock, deadline, ready);
+    }
+
+    void notify_waiters() override {
+        { std::lock_guard<std::mutex> lock(mtx); }
+        cv.notify_all();
+    }
+
+private:
+    std::mutex mtx;
+    std::condition_variable cv;
+};
+
+// Reloj compartido de tiempo real que se usa por defecto
+inline Clock& real_time_clock() {
+    static RealClock clock;
+    return clock;
+}
+
+// Reloj de tiempo simulado. El tiempo solo avanza cuando todos los hilos participantes están esperando:
+// entonces salta directamente al plazo más próximo. Una hora de escenario se reproduce en lo que tarde
+// la CPU en hacer el trabajo, y el resultado no depende de la carga de la máquina.
+// Todas las esperas de los participantes deben pasar por el reloj (sleep_until, wait_until o
+// begin_external_wait); si un participante se bloquea por otro medio, el tiempo se detiene.
+class SimulatedClock : public Clock {
+public:
+    // 'initial_participants' cuenta los hilos que ya usan el reloj al crearlo (normalmente, el hilo principal)
+    explicit SimulatedClock(std::size_t initial_participants = 1) : participants(initial_participants) {}
+
+    time_point now() const override { return time_point(duration(now_ticks.load())); }
+
+    void sleep_until(time_point when) override {
+        wait_until(when, [] { return false; });
+    }
+
+    bool wait_until(time_point deadline, const std::function<bool()>& ready) override {
+        std::unique_lock<std::mutex> lock(mtx);
+        Waiter self{deadline, &ready};
+        waiters.push_back(&self);
+        bool result = false;
+        while (true) {
+            if (ready()) {
+                result = true;
+                break;
+            }
+            if (now() >= deadline) {
+                break;
+            }
+            advance_if_idle();
+            if (ready() || now() >= deadline) {
+                continue;
+            }
+            cv.wait(lock);
+        }
+        waiters.erase(std::find(waiters.begin(), waiters.end(), &self));
+        return result;
+    }
+
+    void notify_waiters() override {
+        { std::lock_guard<std::mutex> lock(mtx); }
+        cv.notify_all();
+    }
+
+    bool is_simulated() const override { return true; }
+
+    void add_participant() override {
+        std::lock_guard<std::mutex> lock(mtx);
+        ++participants;
+    }
+
+    void remove_participant() override {
+        std::lock_guard<std::mutex> lock(mtx);
+        --participants;
+        advance_if_idle();
+    }
+
+    void begin_external_wait() override {
+        std::lock_guard<std::mutex> lock(mtx);
+        ++external_waiters;
+        advance_if_idle();
+    }
+
+    void end_external_wait() override {
+        std::lock_guard<std::mutex> lock(mtx);
+        --external_waiters;
+    }
+
+private:
+    struct Waiter {
+        time_point deadline;
+        const std::function<bool()>* ready;
+    };
+
+    // Con el mutex tomado: si todos los participantes esperan y ninguno puede continuar,
+    // adelanta el tiempo hasta el plazo más próximo y los despierta
+    void advance_if_idle() {
+        if (waiters.size() + external_waiters < participants) {
+            return;  // Algún hilo sigue trabajando
+        }
+        time_point next = time_point::max();
+        for (const Waiter* waiter : waiters) {
+            if ((*waiter->ready)()) {
+                cv.notify_all();  // Ya puede continuar: el tiempo no avanza hasta que vuelva a esperar
+                return;
+            }
+            next = std::min(next, waiter->deadline);
+        }
+        if (next == time_point::max()) {
+            return;  // Todos esperan un evento sin plazo
+        }
+        if (next > now()) {
+            now_ticks.store(next.time_since_epoch().count());
+        }
+        cv.notify_all();
+    }
+
+    std::atomic<duration::rep> now_ticks{0};
+    std::mutex mtx;
+    std::condition_variable cv;
+    std::vector<Waiter*> waiters;
+    std::size_t participants;
+    std::size_t external_waiters = 0;
+};
+
+// Lanza un hilo que participa en el reloj: en tiempo simulado, el tiempo no avanza mientras trabaja
+template <typename Function, typename... Args>
+std::thread start_clocked_thread(Clock& clock, Function&& function, Args&&... args) {
+    clock.add_participant();
+    return std::thread([&clock, function = std::forward<Function>(function),
+                        ... args = std::forward<Args>(args)]() mutable {
+        struct LeaveClock {
+            Clock& clock;
+            ~LeaveClock() { clock.remove_participant(); }
+        } leave{clock};
+        std::invoke(function, args...);
+    });
+}
+
+// Espera a que termine un hilo sin detener el tiempo simulado mientras tanto
+inline void join_clocked_thread(Clock& clock, std::thread& thread) {
+    clock.begin_external_wait();
+    thread.join();
+    clock.end_external_wait();
+}
+
+#endif  // CLOCK_H
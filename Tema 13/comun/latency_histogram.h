@@ -0,0 +1,120 @@
+#ifndef LATENCY_HISTOGRAM_H
+#define LATENCY_HISTOGRAM_H
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <bit>
+#include <chrono>
+#include <cstdint>
+#include <iomanip>
+#include <iostream>
+#include <string>
+
+// Copia de un histograma en un instante dado, con la que se pueden calcular percentiles
+struct HistogramSnapshot {
+    static constexpr int sub_bucket_bits = 2;  // 4 cubos lineales por cada potencia de dos (error < 25%)
+    static constexpr int bucket_count = 64 << sub_bucket_bits;
+
+    std::array<std::uint64_t, bucket_count> buckets{};
+    std::uint64_t count = 0;
+    std::uint64_t sum_ns = 0;
+    std::uint64_t max_ns = 0;
+
+    // Cubo en el que cae un valor: la potencia de dos más los dos bits siguientes
+    static int bucket_index(std::uint64_t value_ns) {
+        if (value_ns < (1u << sub_bucket_bits)) {
+            return static_cast<int>(value_ns);
+        }
+        int exponent = std::bit_width(value_ns) - 1;
+        int sub_bucket = static_cast<int>((value_ns >> (exponent - sub_bucket_bits)) & ((1u << sub_bucket_bits) - 1));
+        return ((exponent - sub_bucket_bits + 1) << sub_bucket_bits) + sub_bucket;
+    }
+
+    // Mayor valor que cae en el cubo 'index'
+    static std::uint64_t bucket_upper_bound(int index) {
+        if (index < (1 << sub_bucket_bits)) {
+            return static_cast<std::uint64_t>(index);
+        }
+        int exponent = (index >> sub_bucket_bits) + sub_bucket_bits - 1;
+        std::uint64_t sub_bucket = index & ((1 << sub_bucket_bits) - 1);
+        std::uint64_t lower = (std::uint64_t{1} << exponent) + (sub_bucket << (exponent - sub_bucket_bits));
+        return lower + (std::uint64_t{1} << (exponent - sub_bucket_bits)) - 1;
+    }
+
+    // Percentil aproximado (cota superior del cubo), 'p' entre 0 y 1
+    std::chrono::nanoseconds percentile(double p) const {
+        if (count == 0) {
+            return std::chrono::nanoseconds(0);
+        }
+        auto rank = static_cast<std::uint64_t>(p * static_cast<double>(count - 1)) + 1;
+        std::uint64_t seen = 0;
+        for (int i = 0; i < bucket_count; ++i) {
+            seen += buckets[i];
+            if (seen >= rank) {
+                return std::chrono::nanoseconds(std::min(bucket_upper_bound(i), max_ns));
+            }
+        }
+        return std::chrono::nanoseconds(max_ns);
+    }
+
+    std::chrono::nanoseconds mean() const {
+        return std::chrono::nanoseconds(count == 0 ? 0 : sum_ns / count);
+    }
+};
+
+// Histograma de latencias con cubos logarítmicos. record() son unas pocas sumas atómicas relajadas,
+// así que se puede llamar desde los hilos de trabajo y leer en vivo desde cualquier otro hilo
+class LatencyHistogram {
+public:
+    void record(std::chrono::nanoseconds latency) {
+        auto value_ns = static_cast<std::uint64_t>(std::max<std::int64_t>(latency.count(), 0));
+        buckets[HistogramSnapshot::bucket_index(value_ns)].fetch_add(1, std::memory_order_relaxed);
+        sum_ns.fetch_add(value_ns, std::memory_order_relaxed);
+        std::uint64_t current_max = max_ns.load(std::memory_order_relaxed);
+        while (value_ns > current_max && !max_ns.compare_exchange_weak(current_max, value_ns, std::memory_order_relaxed)) {
+        }
+    }
+
+    // Igual que record(), para cuando quien registra ya está serializado por otro medio (por ejemplo, lo hace
+    // con un cerrojo tomado): lecturas y escrituras relajadas en vez de operaciones atómicas de lectura-escritura,
+    // mucho más baratas. Los lectores en vivo siguen viendo valores coherentes
+    void record_serialized(std::chrono::nanoseconds latency) {
+        auto value_ns = static_cast<std::uint64_t>(std::max<std::int64_t>(latency.count(), 0));
+        auto& bucket = buckets[HistogramSnapshot::bucket_index(value_ns)];
+        bucket.store(bucket.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+        sum_ns.store(sum_ns.load(std::memory_order_relaxed) + value_ns, std::memory_order_relaxed);
+        if (value_ns > max_ns.load(std::memory_order_relaxed)) {
+            max_ns.store(value_ns, std::memory_order_relaxed);
+        }
+    }
+
+    HistogramSnapshot snapshot() const {
+        HistogramSnapshot copy;
+        for (int i = 0; i < HistogramSnapshot::bucket_count; ++i) {
+            copy.buckets[i] = buckets[i].load(std::memory_order_relaxed);
+            copy.count += copy.buckets[i];  // Coherente con los cubos aunque se siga registrando
+        }
+        copy.sum_ns = sum_ns.load(std::memory_order_relaxed);
+        copy.max_ns = max_ns.load(std::memory_order_relaxed);
+        return copy;
+    }
+
+private:
+    std::array<std::atomic<std::uint64_t>, HistogramSnapshot::bucket_count> buckets{};
+    std::atomic<std::uint64_t> sum_ns{0};
+    std::atomic<std::uint64_t> max_ns{0};
+};
+
+// Imprime una línea de resumen: número de muestras, media y percentiles en milisegundos
+inline void print_histogram(std::ostream& out, const std::string& name, const HistogramSnapshot& histogram) {
+    auto ms = [](std::chrono::nanoseconds value) { return value.count() / 1e6; };
+    out << std::left << std::setw(20) << name << std::right << std::fixed << std::setprecision(2)
+        << " n=" << histogram.count
+        << " media=" << ms(histogram.mean()) << "ms"
+        << " p50=" << ms(histogram.percentile(0.50)) << "ms"
+        << " p99=" << ms(histogram.percentile(0.99)) << "ms"
+        << " max=" << ms(std::chrono::nanoseconds(histogram.max_ns)) << "ms" << std::endl;
+}
+
+#endif  // LATENCY_HISTOGRAM_H